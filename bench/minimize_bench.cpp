@@ -0,0 +1,158 @@
+/**
+ * DFA minimization benchmark
+ *
+ * Times DFA::minimize() against the previous partition-copying
+ * implementation on random complete DFAs over the DNA alphabet, and checks
+ * that both results accept the same random strings as the input DFA.
+ *
+ * The state counts can differ: the legacy quotient keeps every block,
+ * including states unreachable from the start and the block of states
+ * that can never accept, while minimize() keeps only reachable blocks and
+ * leaves the dead block implicit. Such rows are marked with the legacy
+ * count in brackets.
+ *
+ * Usage: minimize_bench [max_states] [legacy_max_states]
+ */
+
+#include "automata/dfa.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using automata::DFA;
+using automata::StateId;
+using automata::Symbol;
+
+namespace {
+
+// Previous DFA::minimize(): rescans every state for each splitter and copies
+// std::set partitions on every refinement step
+DFA legacyMinimize(const DFA& dfa) {
+    if (dfa.getStates().empty()) return dfa;
+    std::set<StateId> accepting, nonAccepting;
+    for (const auto& [id, state] : dfa.getStates()) {
+        if (state.isAccepting()) accepting.insert(id);
+        else nonAccepting.insert(id);
+    }
+    std::vector<std::set<StateId>> partition;
+    if (!accepting.empty()) partition.push_back(accepting);
+    if (!nonAccepting.empty()) partition.push_back(nonAccepting);
+    std::vector<std::set<StateId>> workList = partition;
+    std::set<Symbol> alphabet = dfa.getAlphabet();
+    while (!workList.empty()) {
+        std::set<StateId> A = workList.back(); workList.pop_back();
+        for (Symbol c : alphabet) {
+            std::set<StateId> X;
+            for (const auto& [id, state] : dfa.getStates()) {
+                auto next = dfa.getNextState(id, c);
+                if (next && A.count(*next)) X.insert(id);
+            }
+            std::vector<std::set<StateId>> newPartition;
+            for (const auto& Y : partition) {
+                std::set<StateId> intersection, difference;
+                for (StateId s : Y) { if (X.count(s)) intersection.insert(s); else difference.insert(s); }
+                if (!intersection.empty() && !difference.empty()) {
+                    newPartition.push_back(intersection); newPartition.push_back(difference);
+                    auto it = std::find(workList.begin(), workList.end(), Y);
+                    if (it != workList.end()) { workList.erase(it); workList.push_back(intersection); workList.push_back(difference); }
+                    else workList.push_back(intersection.size() <= difference.size() ? intersection : difference);
+                } else newPartition.push_back(Y);
+            }
+            partition = newPartition;
+        }
+    }
+    DFA minDfa;
+    std::map<StateId, StateId> stateToPartition;
+    for (size_t i = 0; i < partition.size(); ++i) {
+        bool isAcc = false;
+        for (StateId s : partition[i]) { stateToPartition[s] = i; if (dfa.getAcceptingStates().count(s)) isAcc = true; }
+        minDfa.addState("", isAcc);
+    }
+    minDfa.setStartState(stateToPartition[dfa.getStartState()]);
+    std::set<std::tuple<StateId, StateId, Symbol>> added;
+    for (const auto& t : dfa.getTransitions()) {
+        StateId from = stateToPartition[t.getFrom()], to = stateToPartition[t.getTo()];
+        auto key = std::make_tuple(from, to, t.getSymbol());
+        if (added.find(key) == added.end()) { minDfa.addTransition(from, to, t.getSymbol()); added.insert(key); }
+    }
+    return minDfa;
+}
+
+// Random complete DFA; each state is accepting with probability 1/2
+DFA randomDFA(size_t states, std::mt19937& rng) {
+    DFA dfa;
+    std::bernoulli_distribution coin(0.5);
+    for (size_t i = 0; i < states; ++i) dfa.addState("", coin(rng));
+    std::uniform_int_distribution<StateId> target(0, static_cast<StateId>(states) - 1);
+    for (size_t i = 0; i < states; ++i) {
+        for (Symbol c : std::string("ACGT")) dfa.addTransition(static_cast<StateId>(i), target(rng), c);
+    }
+    return dfa;
+}
+
+// Whether two DFAs agree on random DNA strings of up to 64 bases
+bool sameLanguage(const DFA& a, const DFA& b, std::mt19937& rng) {
+    constexpr int SAMPLES = 2000;
+    std::uniform_int_distribution<size_t> length(0, 64);
+    std::uniform_int_distribution<int> base(0, 3);
+    for (int i = 0; i < SAMPLES; ++i) {
+        std::string input(length(rng), 'A');
+        for (char& c : input) c = "ACGT"[base(rng)];
+        if (a.accepts(input) != b.accepts(input)) return false;
+    }
+    return true;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxStates = (argc >= 2) ? std::stoul(argv[1]) : 32000;
+    size_t legacyMaxStates = (argc >= 3) ? std::stoul(argv[2]) : 2000;
+
+    std::mt19937 rng(42);
+    std::cout << std::left << std::setw(12) << "states"
+              << std::setw(14) << "minimized"
+              << std::setw(14) << "legacy(ms)"
+              << std::setw(14) << "hopcroft(ms)"
+              << "equivalent\n";
+    std::cout << std::string(64, '-') << "\n";
+
+    bool allEquivalent = true;
+    for (size_t n = 1000; n <= maxStates; n *= 2) {
+        DFA dfa = randomDFA(n, rng);
+        DFA minimized;
+        double fast = timeMs([&] { minimized = dfa.minimize(); });
+        bool equivalent = sameLanguage(dfa, minimized, rng);
+
+        std::string legacy = "-";
+        if (n <= legacyMaxStates) {
+            DFA legacyDfa;
+            double ms = timeMs([&] { legacyDfa = legacyMinimize(dfa); });
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(1) << ms;
+            if (legacyDfa.getStateCount() != minimized.getStateCount()) {
+                // Unreachable and dead states only; the languages must still agree
+                oss << " [" << legacyDfa.getStateCount() << "]";
+                equivalent = equivalent && sameLanguage(legacyDfa, minimized, rng);
+            }
+            legacy = oss.str();
+        }
+        allEquivalent = allEquivalent && equivalent;
+
+        std::cout << std::left << std::setw(12) << n
+                  << std::setw(14) << minimized.getStateCount()
+                  << std::setw(14) << legacy
+                  << std::fixed << std::setprecision(1) << std::setw(14) << fast
+                  << (equivalent ? "yes" : "NO") << "\n";
+    }
+    return allEquivalent ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#ifndef API_PATTERN_CACHE_HPP
+#define API_PATTERN_CACHE_HPP
+
+#include "../automata/dfa_search.hpp"
+#include "../automata/counting_matcher.hpp"
+#include "../automata/nfa.hpp"
+#include "../bio/hamming_matcher.hpp"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace api {
+
+/**
+ * @brief Everything that changes a compiled pattern
+ *
+ * Per-request options that only affect how the pattern is used (such as
+ * searching the reverse-complement strand) are not part of the key.
+ */
+struct PatternKey {
+    enum Flags : unsigned {
+        REGEX = 1           // Pattern is a regular expression, not a literal
+    };
+
+    std::string pattern;     // Normalized (uppercase)
+    unsigned flags = 0;
+    int maxDistance = 0;     // Literals only; always 0 for regexes
+    std::string alphabet = "DNA";
+};
+
+/**
+ * @brief A pattern compiled for /api/bio/match
+ */
+struct CompiledPattern {
+    std::string pattern;                            // Normalized (uppercase) pattern
+    std::optional<automata::DFASearcher> searcher;  // Set for REGEX patterns
+    std::optional<automata::CountingMatcher> counting;  // Instead of searcher when {m,n} is too large to unroll
+    std::optional<automata::NFA> nfa;               // Instead of searcher when its DFAs are too large;
+                                                    // each request scans it with its own LazyDFA
+    std::optional<bio::HammingMatcher> hamming;     // Set for literals: k-mismatch scanner
+    std::string engine;                             // Which of the above runs, reported as matchType
+    std::optional<size_t> dfaStates;                // States of the minimized DFA, when searcher is set
+};
+
+/**
+ * @brief Thread-safe LRU cache of compiled patterns
+ *
+ * Entries are shared_ptrs, so a request keeps using its pattern even if
+ * another request evicts it meanwhile. Compilation runs outside the lock;
+ * two threads missing on the same key at once may both compile it, and the
+ * first result inserted is kept. A capacity of 0 disables caching.
+ */
+class PatternCache {
+public:
+    using Compiler = std::function<std::shared_ptr<const CompiledPattern>(const PatternKey&)>;
+
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    PatternCache(size_t capacity, Compiler compiler);
+
+    /**
+     * @brief Compiled form of key, compiling it on a miss
+     *
+     * Exceptions thrown by the compiler propagate and nothing is cached.
+     */
+    std::shared_ptr<const CompiledPattern> get(const PatternKey& key);
+
+    /**
+     * @brief Compile and insert key without counting a hit or miss
+     *
+     * Used to preload known motifs at startup; exceptions propagate.
+     */
+    void warmUp(const PatternKey& key);
+
+    // Statistics
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    size_t size() const;
+    size_t getCapacity() const { return capacity_; }
+
+    void clear();
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const CompiledPattern>>;
+
+    size_t capacity_;
+    Compiler compiler_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    uint64_t hits_;
+    uint64_t misses_;
+
+    static std::string encode(const PatternKey& key);
+
+    // Insert under the lock; returns the entry now cached for the key
+    std::shared_ptr<const CompiledPattern> insert(const std::string& encoded,
+                                                  std::shared_ptr<const CompiledPattern> compiled);
+};
+
+} // namespace api
+
+#endif // API_PATTERN_CACHE_HPP
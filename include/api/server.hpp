@@ -1,6 +1,7 @@
 #ifndef API_SERVER_HPP
 #define API_SERVER_HPP
 
+#include "pattern_cache.hpp"
 #include <string>
 #include <functional>
 
@@ -18,8 +19,10 @@ public:
      * @brief Construct the API server
      * @param port The port to listen on (default: 5000)
      * @param staticDir Directory for static files (default: "./vite/dist")
+     * @param cacheCapacity Compiled patterns kept in the LRU cache (0 disables it)
      */
-    Server(int port = 5000, const std::string& staticDir = "./vite/dist");
+    Server(int port = 5000, const std::string& staticDir = "./vite/dist",
+           size_t cacheCapacity = PatternCache::DEFAULT_CAPACITY);
     
     /**
      * @brief Start the server (blocking)
@@ -35,11 +38,26 @@ public:
      * @brief Check if server is running
      */
     bool isRunning() const { return running_; }
+    
+    /**
+     * @brief Precompile patterns listed in a file
+     * 
+     * One pattern per line, optionally followed by a maximum distance;
+     * blank lines and lines starting with '#' are ignored. Entries are
+     * compiled as /api/bio/match would (both strands). Invalid lines are
+     * reported on stderr and skipped.
+     * @return Number of patterns loaded
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    size_t warmUpCache(const std::string& path);
+    
+    PatternCache& getPatternCache() { return cache_; }
 
 private:
     int port_;
     std::string staticDir_;
     bool running_;
+    PatternCache cache_;
     
     // JSON helpers
     static std::string jsonError(const std::string& message);
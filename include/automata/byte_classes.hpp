@@ -0,0 +1,52 @@
+#ifndef AUTOMATA_BYTE_CLASSES_HPP
+#define AUTOMATA_BYTE_CLASSES_HPP
+
+#include "common.hpp"
+#include "transition.hpp"
+#include <array>
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Partition of the 256 byte values into alphabet equivalence classes
+ *
+ * Two symbols share a class when every transition of the automaton treats
+ * them identically, so determinization, minimization and table layout only
+ * need one column per class. Class 0 always holds the bytes that label no
+ * transition at all (including EPSILON); such bytes can only lead to the
+ * dead state.
+ */
+class ByteClasses {
+public:
+    /**
+     * @brief Trivial partition: every byte in class 0
+     */
+    ByteClasses();
+
+    /**
+     * @brief Compute the coarsest partition respected by a set of transitions
+     */
+    static ByteClasses fromTransitions(const std::vector<Transition>& transitions);
+    static ByteClasses fromNFA(const NFA& nfa);
+    static ByteClasses fromDFA(const DFA& dfa);
+
+    // Class lookup
+    uint8_t get(Symbol s) const { return classes_[static_cast<unsigned char>(s)]; }
+    size_t getClassCount() const { return members_.size(); }
+
+    // Symbols of one class, in increasing byte order
+    const std::vector<Symbol>& getMembers(size_t cls) const { return members_[cls]; }
+    Symbol getRepresentative(size_t cls) const { return members_[cls].front(); }
+
+    // String representation
+    std::string toString() const;
+
+private:
+    std::array<uint8_t, 256> classes_;
+    std::vector<std::vector<Symbol>> members_;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_BYTE_CLASSES_HPP
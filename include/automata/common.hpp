@@ -24,6 +24,7 @@ namespace automata {
 class State;
 class Transition;
 class NFA;
+class FrozenNFA;
 class DFA;
 class PDA;
 
@@ -36,6 +37,13 @@ using StackSymbol = char;
 constexpr char EPSILON = '\0';  // Epsilon transition symbol
 constexpr char STACK_EMPTY = '$';  // Bottom of stack marker
 
+// Match semantics for searching text with an automaton
+enum class MatchKind {
+    LEFTMOST_LONGEST,   // Non-overlapping; leftmost start, longest match there (POSIX)
+    LEFTMOST_SHORTEST,  // Non-overlapping; leftmost start, shortest match there
+    ALL_OVERLAPPING     // Every (start, end) pair whose substring is accepted
+};
+
 // Exception classes
 class AutomataException : public std::runtime_error {
 public:
@@ -0,0 +1,108 @@
+#ifndef AUTOMATA_COMPILED_DFA_HPP
+#define AUTOMATA_COMPILED_DFA_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace automata {
+
+/**
+ * @brief Immutable table-driven form of a DFA for high-throughput scanning
+ *
+ * States are renumbered contiguously with index 0 reserved for an explicit
+ * dead state that loops to itself. Transitions live in one flat row-major
+ * table of (states x columns) entries, where every input byte is first
+ * mapped to its column; bytes outside the alphabet share a column that
+ * always leads to the dead state. Rows are padded to a power of two so a
+ * transition is a shift, an or and a load. Accepting states are stored as
+ * a bitset. Scanning allocates nothing.
+ */
+class CompiledDFA {
+public:
+    using Index = uint32_t;
+    static constexpr Index DEAD = 0;
+
+    CompiledDFA();
+
+    /**
+     * @brief Compile a DFA into its flat-table form
+     * @param dfa Source automaton (missing transitions go to the dead state)
+     */
+    static CompiledDFA fromDFA(const DFA& dfa);
+
+    // Getters
+    Index getStartState() const { return start_; }
+    size_t getStateCount() const { return stateCount_; }
+    size_t getColumnCount() const { return columnCount_; }
+    uint8_t getColumn(unsigned char byte) const { return columns_[byte]; }
+    size_t getMemoryUsage() const;
+
+    // Single transition
+    Index next(Index state, unsigned char byte) const {
+        return table_[(static_cast<size_t>(state) << strideShift_) | columns_[byte]];
+    }
+
+    bool isAccepting(Index state) const {
+        return (accepting_[state >> 6] >> (state & 63)) & 1;
+    }
+
+    bool isDead(Index state) const { return state == DEAD; }
+
+    /**
+     * @brief Run the automaton over a buffer
+     * @return State reached after consuming all of data (DEAD if it died)
+     */
+    Index run(Index state, const char* data, size_t length) const;
+
+    // Acceptance testing
+    bool accepts(const std::string& input) const;
+    bool accepts(const char* data, size_t length) const;
+
+    static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Automaton for Σ*L: accepts after every prefix that ends with a match
+     * @param maxStates Largest result (dead state included)
+     * @throws AutomataException if the subset construction exceeds maxStates
+     *
+     * Scanning text once with it reports every match end position.
+     */
+    CompiledDFA unanchored(size_t maxStates = UNLIMITED) const;
+
+    /**
+     * @brief Automaton for the reversed language
+     * @param unanchored Build Σ*·reverse(L) instead of reverse(L)
+     * @param maxStates Largest result (dead state included)
+     * @throws AutomataException if the subset construction exceeds maxStates
+     *
+     * Scanning backwards from a match end with the anchored form reports
+     * every start of a match ending there; scanning the whole text backwards
+     * with the unanchored form reports every position where a match starts.
+     * Both can be exponentially larger than this automaton.
+     */
+    CompiledDFA reversed(bool unanchored = false, size_t maxStates = UNLIMITED) const;
+
+private:
+    std::array<uint8_t, 256> columns_;
+    std::vector<Index> table_;
+    std::vector<uint64_t> accepting_;
+    Index start_;
+    size_t stateCount_;
+    size_t columnCount_;
+    unsigned strideShift_;
+
+    // Subset construction over this automaton's layout; restart states are
+    // added to every successor set (used for the Σ* prefix)
+    template <typename Successors>
+    static CompiledDFA determinize(const CompiledDFA& layout, const std::vector<Index>& initial,
+                                   const std::vector<Index>& restart,
+                                   const std::vector<bool>& accepting, size_t maxStates,
+                                   Successors successors);
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_COMPILED_DFA_HPP
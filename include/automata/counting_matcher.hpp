@@ -0,0 +1,130 @@
+#ifndef AUTOMATA_COUNTING_MATCHER_HPP
+#define AUTOMATA_COUNTING_MATCHER_HPP
+
+#include "common.hpp"
+#include "regex_parser.hpp"
+#include "symbol_set.hpp"
+#include "sparse_set.hpp"
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Regex matcher with counters for bounded repetition
+ *
+ * RegexParser unrolls `X{m,n}` into n copies of X, so `N{50,500}` or
+ * `(ACGT){1000}` costs hundreds or thousands of states. Here a repetition
+ * whose unrolled size would exceed Options::unrollLimit is compiled once,
+ * with a counter attached: every state of its body carries a bit-vector of
+ * the iteration counts it is currently active with (bit c = c iterations
+ * done). Entering the body sets bit 0, finishing an iteration shifts the
+ * vector left by one, and leaving it tests bits m-1..n-1. Because body
+ * transitions do not depend on the count, one vector per state describes
+ * all configurations exactly, and memory is O(states x n / 64) words.
+ *
+ * Cheap repetitions are still unrolled; a repetition that contains a
+ * counter is always unrolled, so counters never nest and each state carries
+ * at most one vector. `X{m,}` is counted as `X{m}X*`. The parser rejects
+ * bounds above MAX_COUNT. Each vector only stores the words up to its
+ * highest set bit, so a scan pays for the counts that are reached, not for
+ * the maximum.
+ *
+ * Matching is set simulation over (state, counts); findAll() uses the same
+ * passes as LazyDFA, and returns the same matches as DFASearcher on the
+ * unrolled automaton.
+ */
+class CountingMatcher {
+public:
+    using Match = std::pair<size_t, size_t>;
+
+    static constexpr uint32_t MAX_COUNT = RegexParser::MAX_REPEAT;  // Largest repetition bound accepted
+
+    struct Options {
+        size_t unrollLimit = 256;  // Unroll {m,n} if the copies need at most this many states
+    };
+
+    /**
+     * @brief Compile a pattern
+     * @throws ParseException for invalid patterns and for repetition bounds above MAX_COUNT
+     */
+    explicit CountingMatcher(const std::string& pattern);
+    CountingMatcher(const std::string& pattern, const Options& options);
+
+    // Acceptance testing
+    bool accepts(const std::string& input) const;
+
+    // Same results as DFASearcher(DFA::fromNFA(RegexParser().parse(pattern)), kind).findAll(text)
+    std::vector<Match> findAll(const std::string& text, MatchKind kind = MatchKind::LEFTMOST_LONGEST) const;
+
+    size_t getStateCount() const { return forward_.size(); }
+    size_t getCounterCount() const { return forward_.counters.size(); }
+    const Options& getOptions() const { return options_; }
+
+private:
+    enum class Op : uint8_t {
+        PLAIN,  // Copy the counts
+        ENTER,  // Into a counted body: counts = {0}
+        LOOP,   // Body end to body start: every count + 1, below max
+        EXIT    // Out of a counted body: any count + 1 in [min, max]
+    };
+
+    struct EpsilonEdge {
+        uint32_t to;
+        Op op;
+        uint32_t counter;  // For ENTER, LOOP and EXIT
+    };
+
+    struct Counter {
+        uint32_t min;
+        uint32_t max;
+    };
+
+    // Dense automaton; per-state edge lists in CSR form
+    struct Program {
+        std::vector<uint32_t> wordStart;   // Activation words of state q: [wordStart[q], wordStart[q + 1])
+        std::vector<uint32_t> symbolStart;
+        std::vector<std::pair<SymbolSet, uint32_t>> symbolEdges;
+        std::vector<uint32_t> epsilonStart;
+        std::vector<EpsilonEdge> epsilonEdges;
+        std::vector<Counter> counters;
+        uint32_t start = 0;
+        uint32_t accept = 0;
+        size_t size() const { return symbolStart.empty() ? 0 : symbolStart.size() - 1; }
+    };
+
+    // Active states and their count vectors; words of inactive states are
+    // stale, and so are the words of an active state q from used[q] on
+    // (they count as zero)
+    struct Threads {
+        SparseSet states;
+        std::vector<uint64_t> words;
+        std::vector<uint32_t> used;
+        std::vector<uint32_t> pending;  // Closure work list
+        std::vector<uint64_t> scratch;
+
+        explicit Threads(const Program& program)
+            : states(program.size()), words(program.wordStart.back()), used(program.size()) {}
+    };
+
+    class Compiler;
+
+    Options options_;
+    Program forward_;
+    Program reverse_;  // Built from the mirrored AST
+
+    static bool merge(const Program& program, Threads& threads, uint32_t q, const uint64_t* bits, uint32_t count);
+    static void closure(const Program& program, Threads& threads);
+    static void step(const Program& program, const Threads& current, unsigned char byte, Threads& next);
+    static void addStart(const Program& program, Threads& threads);
+
+    // Scan data[begin, end) (backwards if requested), calling visit(offset)
+    // at every accepting offset until it returns false or no thread is left.
+    // With restart the start state is re-added at every offset (Σ* prefix).
+    template <typename Visit>
+    static void scan(const Program& program, const unsigned char* data, size_t begin, size_t end,
+                     bool backward, bool restart, Visit visit);
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_COUNTING_MATCHER_HPP
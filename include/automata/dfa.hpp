@@ -5,9 +5,14 @@
 #include "state.hpp"
 #include "transition.hpp"
 #include "nfa.hpp"
+#include "byte_classes.hpp"
+#include <array>
 
 namespace automata {
 
+class CompiledDFA;
+class DFASearcher;
+
 /**
  * @brief Deterministic Finite Automaton
  * 
@@ -32,7 +37,7 @@ public:
     std::optional<StateId> getNextState(StateId from, Symbol symbol) const;
     const std::vector<Transition>& getTransitions() const { return transitions_; }
     
-    // Acceptance testing
+    // Acceptance testing (runs on the cached flat table, see getCompiled)
     bool accepts(const std::string& input) const;
     
     // Execution trace for visualization
@@ -44,15 +49,26 @@ public:
     };
     std::vector<ExecutionStep> traceExecution(const std::string& input) const;
     
-    // Match all occurrences in text
+    // Match all occurrences in text (every accepted substring starting before text end)
     std::vector<std::pair<size_t, size_t>> findAllMatches(const std::string& text) const;
     
+    // Single-pass unanchored search with the given match semantics (see DFASearcher).
+    // The searcher is built once per kind; if its automata would exceed
+    // DFASearcher::Options::maxStates, the DFA is restarted at every position instead.
+    std::vector<std::pair<size_t, size_t>> findAllMatches(const std::string& text, MatchKind kind) const;
+    
     // Get alphabet
     std::set<Symbol> getAlphabet() const;
     
+    // Alphabet equivalence classes (cached from fromNFA/minimize, else computed)
+    ByteClasses getByteClasses() const;
+    
     // Get all states
     const std::map<StateId, State>& getStates() const { return states_; }
     
+    // Flat-table form, compiled on first use and rebuilt after any modification
+    std::shared_ptr<const CompiledDFA> getCompiled() const;
+    
     // String representation
     std::string toString() const;
     
@@ -64,6 +80,8 @@ public:
     
     // Subset construction from NFA
     static DFA fromNFA(const NFA& nfa);
+    // Same, but throws AutomataException once the DFA would exceed maxStates states
+    static DFA fromNFA(const NFA& nfa, size_t maxStates);
     
     // Minimization using Hopcroft's algorithm
     DFA minimize() const;
@@ -92,6 +110,13 @@ private:
     std::set<StateId> acceptingStates_;
     StateId nextStateId_;
     std::set<Symbol> alphabet_;
+    std::optional<ByteClasses> byteClasses_;
+    // Shared between copies; the pointer is replaced, never the pointee
+    mutable std::shared_ptr<const CompiledDFA> compiled_;
+    // One per MatchKind; an empty optional means the searcher was too large
+    mutable std::array<std::shared_ptr<const std::optional<DFASearcher>>, 3> searchers_;
+
+    void invalidateCaches();
 };
 
 } // namespace automata
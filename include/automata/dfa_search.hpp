@@ -0,0 +1,97 @@
+#ifndef AUTOMATA_DFA_SEARCH_HPP
+#define AUTOMATA_DFA_SEARCH_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include "compiled_dfa.hpp"
+#include "shuffle_dfa.hpp"
+#include "strided_dfa.hpp"
+#include "prefilter.hpp"
+
+namespace automata {
+
+/**
+ * @brief Linear-time unanchored search with a DFA
+ *
+ * Instead of restarting the automaton at every text position, the searcher
+ * compiles derived automata once and scans the text a constant number of
+ * times:
+ *
+ *  - ALL_OVERLAPPING: one forward pass with Σ*L reports every match end;
+ *    an anchored reverse(L) scan from each end recovers all of its starts.
+ *  - LEFTMOST_LONGEST / LEFTMOST_SHORTEST: one backward pass with Σ*·reverse(L)
+ *    marks every position where a match starts; the anchored forward DFA
+ *    then runs from each selected start to find the longest (or shortest)
+ *    match end. Matches do not overlap. A longest scan continues past its
+ *    match until the DFA dies; the (position, state) pairs it visits there
+ *    are remembered and end later scans early, so the forward scans take
+ *    O(n * states) steps in total even when they would otherwise overlap.
+ *
+ * Results are (start, end) pairs sorted by start, then end. The full-text
+ * pass runs on the PSHUFB engine (ShuffleDFA) whenever its automaton has at
+ * most 16 states, which covers most short motifs. Larger automata that read
+ * only A, C, G and T take four bases per step (StridedDFA) when the table fits.
+ *
+ * With a LiteralPrefilter attached, the passes only run over the regions
+ * around occurrences of the pattern's required literal (every match lies
+ * inside one of them), unless those regions cover most of the text.
+ */
+class DFASearcher {
+public:
+    using Match = std::pair<size_t, size_t>;
+
+    struct Options {
+        size_t maxStates = 1 << 16;  // States per derived automaton before construction gives up
+    };
+
+    /**
+     * @brief Compile the automata needed for one match kind
+     * @param dfa Pattern automaton (usually minimized)
+     * @param kind Match semantics
+     * @throws AutomataException if a derived automaton exceeds Options::maxStates
+     *         (the Σ* prefix can blow up exponentially, e.g. for A[ACGT]{20})
+     */
+    explicit DFASearcher(const DFA& dfa, MatchKind kind = MatchKind::LEFTMOST_LONGEST);
+    DFASearcher(const DFA& dfa, MatchKind kind, const Options& options);
+    explicit DFASearcher(const CompiledDFA& dfa, MatchKind kind = MatchKind::LEFTMOST_LONGEST);
+    DFASearcher(const CompiledDFA& dfa, MatchKind kind, const Options& options);
+
+    /**
+     * @brief Compile a regex: minimized DFA plus its required-literal prefilter
+     * @throws ParseException if the pattern is invalid
+     * @throws AutomataException if the pattern DFA or a derived automaton
+     *         exceeds Options::maxStates
+     */
+    static DFASearcher fromPattern(const std::string& pattern, MatchKind kind = MatchKind::LEFTMOST_LONGEST);
+    static DFASearcher fromPattern(const std::string& pattern, MatchKind kind, const Options& options);
+
+    MatchKind getMatchKind() const { return kind_; }
+
+    // Compiled automata driving the forward and backward passes
+    const CompiledDFA& getForward() const { return forward_; }
+    const CompiledDFA& getReverse() const { return reverse_; }
+
+    // The prefilter must match the automaton's language (see LiteralPrefilter)
+    void setPrefilter(std::optional<LiteralPrefilter> prefilter) { prefilter_ = std::move(prefilter); }
+    const std::optional<LiteralPrefilter>& getPrefilter() const { return prefilter_; }
+
+    // Find all matches in text
+    std::vector<Match> findAll(const std::string& text) const;
+    std::vector<Match> findAll(const char* data, size_t length) const;
+
+private:
+    MatchKind kind_;
+    CompiledDFA forward_;   // Σ*L for ALL_OVERLAPPING, otherwise L
+    CompiledDFA reverse_;   // reverse(L) for ALL_OVERLAPPING, otherwise Σ*·reverse(L)
+    std::optional<ShuffleDFA> scanner_;  // Vectorized full-text pass, if small enough
+    std::optional<StridedDFA> strided_;  // Otherwise 4 bases per step, for DNA-only automata
+    std::optional<LiteralPrefilter> prefilter_;
+
+    std::vector<Match> findOverlapping(const unsigned char* text, size_t length) const;
+    std::vector<Match> findLeftmost(const unsigned char* text, size_t length) const;
+    std::vector<Match> findInText(const unsigned char* text, size_t length) const;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_DFA_SEARCH_HPP
@@ -0,0 +1,141 @@
+#ifndef AUTOMATA_FROZEN_NFA_HPP
+#define AUTOMATA_FROZEN_NFA_HPP
+
+#include "common.hpp"
+#include "nfa.hpp"
+#include "sparse_set.hpp"
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Immutable NFA with compressed-sparse-row adjacency
+ *
+ * States are renumbered densely (in StateId order) and the outgoing edges
+ * of each state are stored contiguously, split into epsilon edges and
+ * symbol edges; symbol edges are sorted by symbol so the edges for one
+ * symbol are a binary search away. Simulation steps then touch only the
+ * edges of the states involved instead of the whole transition list.
+ *
+ * State sets are sorted vectors of dense indices. Closure and move take a
+ * caller-owned SparseSet of getStateCount() capacity as scratch.
+ *
+ * When the NFA is small enough (MAX_CLOSURE_TABLE_BYTES), the epsilon
+ * closure of every state is also precomputed as a bitset row, which lets
+ * NFASimulator advance a whole state set with word-wide ORs.
+ */
+class FrozenNFA {
+public:
+    using Index = uint32_t;
+
+    struct Edge {
+        Symbol symbol;
+        Index to;
+    };
+
+    template <typename T>
+    struct Range {
+        const T* first;
+        const T* last;
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    static constexpr size_t MAX_CLOSURE_TABLE_BYTES = 16 << 20;
+
+    FrozenNFA();
+
+    static FrozenNFA fromNFA(const NFA& nfa);
+
+    // Getters
+    size_t getStateCount() const { return ids_.size(); }
+    bool hasStartState() const { return hasStart_; }
+    Index getStartState() const { return start_; }
+    bool isAccepting(Index state) const { return accepting_[state]; }
+    StateId getStateId(Index state) const { return ids_[state]; }
+
+    // Adjacency
+    Range<Index> getEpsilonEdges(Index state) const {
+        return {epsilon_.data() + epsilonStart_[state], epsilon_.data() + epsilonStart_[state + 1]};
+    }
+    Range<Edge> getSymbolEdges(Index state) const {
+        return {symbols_.data() + symbolStart_[state], symbols_.data() + symbolStart_[state + 1]};
+    }
+    Range<Edge> getSymbolEdges(Index state, Symbol symbol) const;
+
+    // Set operations on sorted index vectors
+    void epsilonClosure(std::vector<Index>& states, SparseSet& scratch) const;
+    void move(const std::vector<Index>& states, Symbol symbol, std::vector<Index>& out,
+              SparseSet& scratch) const;
+    bool anyAccepting(const std::vector<Index>& states) const;
+
+    // Initial set: closure of the start state (empty without one)
+    std::vector<Index> initialStates(SparseSet& scratch) const;
+
+    // Precomputed closures: row q is the bitset of ε-closure({q})
+    bool hasClosureTable() const { return hasClosures_; }
+    size_t getWordCount() const { return words_; }
+    const uint64_t* getClosureRow(Index state) const { return closures_.data() + state * words_; }
+    const uint64_t* getAcceptMask() const { return acceptMask_.data(); }
+
+    std::set<StateId> toStateIds(const std::vector<Index>& states) const;
+
+private:
+    std::vector<StateId> ids_;
+    std::vector<uint32_t> epsilonStart_;
+    std::vector<Index> epsilon_;
+    std::vector<uint32_t> symbolStart_;
+    std::vector<Edge> symbols_;
+    std::vector<bool> accepting_;
+    Index start_;
+    bool hasStart_;
+    bool hasClosures_;
+    size_t words_;
+    std::vector<uint64_t> closures_;
+    std::vector<uint64_t> acceptMask_;
+
+    void buildClosureTable();
+};
+
+/**
+ * @brief Reusable NFA simulation over a FrozenNFA
+ *
+ * Holds the current state set and scratch space, so stepping allocates
+ * nothing. With a closure table the set is a bitset and a step ORs the
+ * closure rows of every symbol-edge target; otherwise it is a sparse set
+ * closed by depth-first search.
+ */
+class NFASimulator {
+public:
+    explicit NFASimulator(const FrozenNFA& nfa);
+
+    // Restart from the closure of the start state, or of the given states
+    void reset();
+    void reset(const std::vector<FrozenNFA::Index>& states);
+
+    // Consume one symbol; returns false once the set is empty
+    bool step(Symbol symbol);
+
+    bool empty() const { return empty_; }
+    bool isAccepting() const;
+
+    // Current set as sorted dense indices
+    std::vector<FrozenNFA::Index> getStates() const;
+
+private:
+    const FrozenNFA* nfa_;
+    bool useBits_;
+    bool empty_;
+    std::vector<uint64_t> current_;
+    std::vector<uint64_t> next_;
+    SparseSet currentSet_;
+    SparseSet nextSet_;
+
+    void closeSparse(SparseSet& set) const;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_FROZEN_NFA_HPP
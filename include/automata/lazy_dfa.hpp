@@ -0,0 +1,112 @@
+#ifndef AUTOMATA_LAZY_DFA_HPP
+#define AUTOMATA_LAZY_DFA_HPP
+
+#include "common.hpp"
+#include "nfa.hpp"
+#include "byte_classes.hpp"
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief DFA built on demand from an NFA while scanning
+ *
+ * Instead of running the full subset construction up front, each DFA state
+ * (an epsilon-closed set of NFA states) and each transition is created the
+ * first time the scan needs it and cached in a flat table. Every cache has
+ * a memory budget; when a new state does not fit, the cache is flushed and
+ * the scan continues from the state it was about to enter. A scan that
+ * flushes more than Options::maxFlushes times stops caching and finishes
+ * with plain NFA set simulation, so memory stays bounded whatever the
+ * pattern.
+ *
+ * Search uses the same passes as DFASearcher, with one lazily built cache
+ * for each automaton involved (forward or reverse, anchored or Σ*-prefixed).
+ * Scanning mutates the caches, so an instance must not be shared between
+ * threads.
+ */
+class LazyDFA {
+public:
+    using Match = std::pair<size_t, size_t>;
+
+    struct Options {
+        size_t maxCacheBytes = 8 << 20;  // Budget for each cache
+        size_t maxFlushes = 8;           // Flushes per scan before NFA fallback
+    };
+
+    struct Stats {
+        size_t statesBuilt = 0;   // DFA states created, over all caches
+        size_t cacheFlushes = 0;
+        size_t nfaFallbacks = 0;  // Scans finished by NFA simulation
+    };
+
+    explicit LazyDFA(const NFA& nfa);
+    LazyDFA(const NFA& nfa, const Options& options);
+
+    // Acceptance testing
+    bool accepts(const std::string& input);
+
+    // Same results as DFASearcher(DFA::fromNFA(nfa), kind).findAll(text)
+    std::vector<Match> findAll(const std::string& text, MatchKind kind = MatchKind::LEFTMOST_LONGEST);
+
+    const Stats& getStats() const { return stats_; }
+    const Options& getOptions() const { return options_; }
+    // Memory currently held by all caches (estimate, bytes)
+    size_t getCacheMemoryUsage() const;
+
+private:
+    // Dense copy of the NFA: per-state epsilon and (column, target) edges
+    struct Program {
+        std::vector<uint32_t> epsilonStart;
+        std::vector<uint32_t> epsilon;
+        std::vector<uint32_t> edgeStart;
+        std::vector<std::pair<uint8_t, uint32_t>> edges;
+        std::vector<bool> accepting;
+        std::vector<uint32_t> initial;  // Start states before closure
+        size_t size() const { return accepting.size(); }
+    };
+
+    using Index = uint32_t;
+    static constexpr Index UNKNOWN = UINT32_MAX;
+
+    // One lazily determinized automaton with its own state cache
+    struct Cache {
+        const Program* program = nullptr;
+        bool restart = false;              // Re-add initial states on every step (Σ* prefix)
+        std::vector<uint32_t> start;       // Closure of the initial states
+        std::vector<std::vector<uint32_t>> sets;
+        std::vector<bool> accepting;
+        std::vector<Index> table;          // sets.size() x columns, UNKNOWN if not built yet
+        std::unordered_map<std::string, Index> index;
+        size_t memory = 0;
+        std::vector<uint32_t> mark;        // Scratch for closures
+        uint32_t generation = 0;
+    };
+
+    Options options_;
+    ByteClasses classes_;
+    size_t columns_;
+    Program forward_;
+    Program reverse_;
+    Cache anchored_;          // L
+    Cache unanchored_;        // Σ*L
+    Cache reverseAnchored_;   // reverse(L)
+    Cache reverseUnanchored_; // Σ*·reverse(L)
+    Stats stats_;
+
+    void initCache(Cache& cache, const Program& program, bool restart);
+    void successors(Cache& cache, const std::vector<uint32_t>& from, uint8_t column,
+                    std::vector<uint32_t>& out);
+    Index insert(Cache& cache, const std::vector<uint32_t>& set);
+    void flush(Cache& cache);
+    bool isAccepting(const Cache& cache, const std::vector<uint32_t>& set) const;
+
+    // Scan data[begin, end) (backwards if requested), calling visit(offset)
+    // at every accepting offset until it returns false or the automaton dies
+    template <typename Visit>
+    void scan(Cache& cache, const unsigned char* data, size_t begin, size_t end, bool backward, Visit visit);
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_LAZY_DFA_HPP
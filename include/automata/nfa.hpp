@@ -34,6 +34,7 @@ public:
     
     // Transition management
     void addTransition(StateId from, StateId to, Symbol symbol);
+    void addTransition(StateId from, StateId to, const SymbolSet& symbols);  // Class edge
     void addEpsilonTransition(StateId from, StateId to);
     const std::vector<Transition>& getTransitions() const { return transitions_; }
     
@@ -53,6 +54,12 @@ public:
     
     // Acceptance testing
     bool accepts(const std::string& input) const;
+
+    // Snapshot with CSR adjacency for fast simulation
+    FrozenNFA freeze() const;
+    
+    // Snapshot built on first use and kept until the NFA changes; shared by copies
+    std::shared_ptr<const FrozenNFA> getFrozen() const;
     
     // Execution trace for visualization
     struct ExecutionStep {
@@ -88,11 +95,16 @@ public:
     static NFA createOptional(NFA&& a);  // a?
 
 private:
+    friend class NFABuilder;
+
     std::map<StateId, State> states_;
     std::vector<Transition> transitions_;
     StateId startState_;
     std::set<StateId> acceptingStates_;
     StateId nextStateId_;
+    mutable std::shared_ptr<const FrozenNFA> frozen_;
+    
+    void invalidateCaches();
     
     // Internal helper for state renumbering during Thompson's construction
     void renumberStates(StateId offset);
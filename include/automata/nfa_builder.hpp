@@ -0,0 +1,69 @@
+#ifndef AUTOMATA_NFA_BUILDER_HPP
+#define AUTOMATA_NFA_BUILDER_HPP
+
+#include "common.hpp"
+#include "nfa.hpp"
+
+namespace automata {
+
+/**
+ * @brief Single-pass Thompson construction over one state arena
+ *
+ * States are allocated from a running counter and transitions appended to
+ * one vector, so combining fragments never renumbers or copies what was
+ * built before. A fragment is a single-entry, single-exit piece of the
+ * automaton; because sub-fragments are built back to back, every fragment
+ * owns a contiguous range of states and of transitions. That range is what
+ * copy() duplicates for counted repetition, and what build() turns into an
+ * NFA. Building is linear in the size of the result.
+ */
+class NFABuilder {
+public:
+    struct Fragment {
+        StateId start;
+        StateId end;                 // The fragment's only accepting state
+        StateId firstState;          // States [firstState, stateEnd)
+        StateId stateEnd;
+        size_t firstTransition;      // Transitions [firstTransition, transitionEnd)
+        size_t transitionEnd;
+    };
+
+    NFABuilder();
+
+    // Leaf fragments
+    Fragment empty();                // Accepts only the empty string
+    Fragment single(Symbol symbol);  // Accepts one symbol
+    Fragment symbols(const SymbolSet& set);  // One class edge accepting any member
+
+    // Combinators; operands must be consecutive fragments (a built right before b)
+    Fragment alternate(const std::vector<Fragment>& alternatives);  // a | b | ...
+    Fragment concat(const Fragment& a, const Fragment& b);          // ab
+    Fragment star(const Fragment& a);                                // a*
+    Fragment plus(const Fragment& a);                                // a+
+    Fragment optional(const Fragment& a);                            // a?
+
+    // Fresh copy of a fragment appended to the arena
+    Fragment copy(const Fragment& fragment);
+
+    /**
+     * @brief Extract a fragment as a standalone NFA
+     *
+     * States are renumbered from 0 in allocation order; the fragment's end
+     * is the only accepting state.
+     */
+    NFA build(const Fragment& fragment) const;
+
+    size_t getStateCount() const { return static_cast<size_t>(nextState_); }
+    size_t getTransitionCount() const { return transitions_.size(); }
+
+private:
+    StateId nextState_;
+    std::vector<Transition> transitions_;
+
+    StateId newState() { return nextState_++; }
+    Fragment finish(StateId start, StateId end, const Fragment& first) const;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_NFA_BUILDER_HPP
@@ -0,0 +1,77 @@
+#ifndef AUTOMATA_PARALLEL_SCAN_HPP
+#define AUTOMATA_PARALLEL_SCAN_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include "compiled_dfa.hpp"
+#include "dfa_search.hpp"
+#include <memory>
+
+namespace automata {
+
+/**
+ * @brief Multi-threaded DFA scanning over large inputs
+ *
+ * The text is split into one chunk per thread. The first chunk runs from
+ * the start state; every other chunk is simulated from a set of candidate
+ * entry states at once, giving a per-chunk map from entry state to exit
+ * state. Identical lanes are merged as they converge, which for most DFAs
+ * leaves a single lane after a few bytes. A sequential prefix scan over
+ * the chunk maps then yields each chunk's true entry state.
+ *
+ * Candidate entry states are either all live states or, when speculating,
+ * the states every live state reaches over a short lookback window that
+ * precedes the chunk. The true entry state always lies in that set, so
+ * speculation never needs a fix-up pass.
+ */
+class ParallelScanner {
+public:
+    using Match = std::pair<size_t, size_t>;
+
+    struct Options {
+        size_t threads = 0;             // 0 = std::thread::hardware_concurrency()
+        size_t minChunkSize = 1 << 16;  // Inputs are never split finer than this
+        bool speculate = true;          // Seed chunks from the lookback window
+        size_t lookback = 64;           // Bytes before a chunk used to speculate
+    };
+
+    explicit ParallelScanner(const DFA& dfa);
+    ParallelScanner(const DFA& dfa, const Options& options);
+
+    // Acceptance testing of the whole input
+    bool accepts(const std::string& text) const;
+
+    /**
+     * @brief All (start, end) matches, in order
+     *
+     * Same result as DFA::findAllMatches(text, MatchKind::ALL_OVERLAPPING).
+     * The Σ*L searcher this needs is built on the first call and shared by
+     * later ones.
+     * @throws AutomataException if that searcher exceeds DFASearcher::Options::maxStates
+     */
+    std::vector<Match> findAllMatches(const std::string& text) const;
+
+private:
+    Options options_;
+    CompiledDFA anchored_;
+    mutable std::shared_ptr<const DFASearcher> searcher_;  // Read/written with std::atomic_load/store
+
+    std::shared_ptr<const DFASearcher> getSearcher() const;
+
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        std::vector<CompiledDFA::Index> entries;  // Sorted candidate entry states
+        std::vector<CompiledDFA::Index> exits;    // exits[i] = state after chunk from entries[i]
+    };
+
+    std::vector<Chunk> split(size_t length) const;
+    void mapChunk(const CompiledDFA& dfa, const unsigned char* text, Chunk& chunk) const;
+    // True entry state of every chunk, followed by the final state
+    std::vector<CompiledDFA::Index> entryStates(const CompiledDFA& dfa, const unsigned char* text,
+                                                std::vector<Chunk>& chunks) const;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_PARALLEL_SCAN_HPP
@@ -0,0 +1,72 @@
+#ifndef AUTOMATA_PREFILTER_HPP
+#define AUTOMATA_PREFILTER_HPP
+
+#include "common.hpp"
+#include "regex_parser.hpp"
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Required-literal prefilter for regex search
+ *
+ * Many motifs contain a literal every match must include (`GAATTC` in
+ * `N{3}GAATTC[AG]`). When the pattern also has a bounded match length L,
+ * every match lies within L bytes of an occurrence of that literal, so a
+ * search only has to run the DFA over the windows around the occurrences.
+ * Occurrences are found with a vectorized substring scan: the first,
+ * middle and last literal bytes are compared at 16 (SSE2) or 32 (AVX2)
+ * positions per step and only positions where all agree are verified.
+ *
+ * fromAST() derives the longest required literal from the pattern's AST;
+ * it returns nothing when the pattern has no literal of at least
+ * MIN_LITERAL_LENGTH bytes or no bound on its match length.
+ */
+class LiteralPrefilter {
+public:
+    using Region = std::pair<size_t, size_t>;  // [begin, end)
+
+    static constexpr size_t MIN_LITERAL_LENGTH = 3;
+
+    enum class Backend { SCALAR, SSE2, AVX2 };
+
+    LiteralPrefilter(const std::string& literal, size_t maxMatchLength);
+
+    static std::optional<LiteralPrefilter> fromAST(const std::shared_ptr<RegexParser::ASTNode>& ast);
+
+    // Longest literal every match of the pattern contains
+    static std::string requiredLiteral(const std::shared_ptr<RegexParser::ASTNode>& ast);
+    // Longest match of the pattern, or nullopt if unbounded
+    static std::optional<size_t> maxMatchLength(const std::shared_ptr<RegexParser::ASTNode>& ast);
+
+    static Backend detectBackend();
+    Backend getBackend() const { return backend_; }
+    // Select a kernel; requests beyond what the CPU supports are lowered
+    void setBackend(Backend backend);
+
+    const std::string& getLiteral() const { return literal_; }
+    size_t getMaxMatchLength() const { return maxMatchLength_; }
+
+    // First occurrence of the literal at or after from, or npos
+    size_t find(const char* data, size_t length, size_t from) const;
+
+    /**
+     * @brief Disjoint, sorted regions that contain every match
+     *
+     * The window of an occurrence at p is [p + |literal| - L, p + L),
+     * clipped to the text; overlapping windows are merged. Gives up
+     * (nullopt) once more than maxRegions regions are needed, as a full
+     * scan is then cheaper.
+     */
+    std::optional<std::vector<Region>> candidateRegions(const char* data, size_t length,
+                                                        size_t maxRegions = SIZE_MAX) const;
+
+private:
+    std::string literal_;
+    size_t maxMatchLength_;
+    Backend backend_;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_PREFILTER_HPP
@@ -0,0 +1,55 @@
+#ifndef AUTOMATA_REGEX_OPTIMIZER_HPP
+#define AUTOMATA_REGEX_OPTIMIZER_HPP
+
+#include "common.hpp"
+#include "regex_parser.hpp"
+
+namespace automata {
+
+/**
+ * @brief Language-preserving rewrites of a regex AST before construction
+ *
+ * Applied bottom-up, producing new nodes (the input tree is not modified):
+ *   - groups are dropped, nested UNION/CONCAT nodes flattened into n-ary ones
+ *     and ε removed from concatenations
+ *   - alternatives that are single characters, classes or `.` merge into one
+ *     CHAR_CLASS; duplicate alternatives are removed and `X|ε` becomes `X?`
+ *   - alternatives sharing a first (then last) element are factored:
+ *     `TAA|TAG|TGA` becomes `T(A[AG]|GA)`. Applied recursively, this turns a
+ *     list of literals into a trie
+ *   - `X**`, `(X?)*`, `(X+)*`, `(X*)?` and similar collapse to `X*`
+ *
+ * Matching only depends on the language, so the optimized tree gives the
+ * same results with fewer states.
+ */
+class RegexOptimizer {
+public:
+    using Node = std::shared_ptr<RegexParser::ASTNode>;
+
+    static Node optimize(const Node& node);
+
+private:
+    using NodeType = RegexParser::NodeType;
+
+    static Node makeNode(NodeType type, std::vector<Node> children = {});
+    static Node optimizeUnion(std::vector<Node> alternatives);
+    static Node optimizeConcat(const std::vector<Node>& parts);
+    static Node optimizeClosure(NodeType type, const Node& child);
+
+    // Factor alternatives on their first (or last) element; false if nothing was shared
+    static bool factor(std::vector<Node>& alternatives, bool suffix);
+
+    // Operands of a chain of nested nodes of one type (through groups)
+    static void collect(const Node& node, NodeType type, std::vector<Node>& operands);
+
+    // Elements of a concatenation, or the node itself; and back
+    static std::vector<Node> sequence(const Node& node);
+    static Node fromSequence(std::vector<Node> parts);
+
+    // Structural identity of two subtrees
+    static std::string key(const Node& node);
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_REGEX_OPTIMIZER_HPP
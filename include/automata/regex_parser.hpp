@@ -3,6 +3,7 @@
 
 #include "common.hpp"
 #include "nfa.hpp"
+#include "nfa_builder.hpp"
 
 namespace automata {
 
@@ -21,6 +22,8 @@ namespace automata {
  */
 class RegexParser {
 public:
+    static constexpr int MAX_REPEAT = 1 << 16;  // Largest bound accepted in {m,n}
+
     RegexParser();
     ~RegexParser() = default;
     
@@ -28,7 +31,8 @@ public:
      * @brief Parse a regular expression and construct an NFA
      * @param pattern The regex pattern
      * @return NFA recognizing the language of the pattern
-     * @throws ParseException if the pattern is invalid
+     * @throws ParseException if the pattern is invalid, including {m,n}
+     *         with m > n or a bound above MAX_REPEAT
      */
     NFA parse(const std::string& pattern);
     
@@ -37,6 +41,14 @@ public:
      */
     std::string getASTString() const { return astString_; }
     
+    /**
+     * @brief Run RegexOptimizer on the AST before construction (default on)
+     *
+     * Off gives the textbook Thompson automaton of the pattern as written.
+     */
+    void setOptimize(bool enabled) { optimize_ = enabled; }
+    bool getOptimize() const { return optimize_; }
+    
     // AST node types for visualization
     enum class NodeType {
         CHAR,
@@ -71,6 +83,13 @@ public:
      */
     std::shared_ptr<ASTNode> getAST() const { return ast_; }
     
+    /**
+     * @brief Parse a regular expression without building its NFA
+     * @return Root of the AST (also available from getAST())
+     * @throws ParseException if the pattern is invalid
+     */
+    std::shared_ptr<ASTNode> parseAST(const std::string& pattern);
+    
     // DNA/RNA specific shortcuts
     static std::string expandDNAShortcuts(const std::string& pattern);
     
@@ -79,6 +98,7 @@ private:
     size_t pos_;
     std::shared_ptr<ASTNode> ast_;
     std::string astString_;
+    bool optimize_;
     
     // Parsing methods (recursive descent)
     std::shared_ptr<ASTNode> parseUnion();
@@ -94,10 +114,12 @@ private:
     bool isAtEnd() const;
     bool isMetaChar(char c) const;
     bool parseCountedQuantifier(int& minRep, int& maxRep);  // Parse {m}, {m,}, {m,n}
-    int parseNumber();  // Parse a decimal number
+    int parseNumber();  // Parse a decimal number; throws ParseException on int overflow
+    void checkRepeatBounds(int minRep, int maxRep) const;  // Throws ParseException if out of range
     
     // NFA construction from AST
     NFA buildNFA(const std::shared_ptr<ASTNode>& node);
+    NFABuilder::Fragment buildFragment(NFABuilder& builder, const std::shared_ptr<ASTNode>& node);
 };
 
 /**
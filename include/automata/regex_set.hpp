@@ -0,0 +1,100 @@
+#ifndef AUTOMATA_REGEX_SET_HPP
+#define AUTOMATA_REGEX_SET_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include "compiled_dfa.hpp"
+#include <array>
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Many regexes compiled into one DFA that remembers which pattern matched
+ *
+ * Each pattern is compiled to a minimized DFA; the set automaton is the
+ * product of their Σ*-prefixed forms, built breadth-first over the common
+ * refinement of their byte classes. A product state is accepting for
+ * exactly the patterns whose component is accepting, and those pattern
+ * indices are stored with the state. Unlike DFA::unionDFA this takes any
+ * number of operands and keeps the origin of every match.
+ *
+ * One forward scan reports which patterns match and where each match ends;
+ * findAll() recovers the starts with each matching pattern's reversed DFA,
+ * as DFASearcher does for ALL_OVERLAPPING. The product can grow
+ * exponentially with the number of patterns, so construction is bounded by
+ * Options::maxStates.
+ */
+class RegexSet {
+public:
+    using Index = uint32_t;
+
+    struct Options {
+        size_t maxStates = 1 << 16;  // Product states before construction gives up
+    };
+
+    struct Match {
+        size_t pattern;  // Index in the constructor's list
+        size_t start;
+        size_t end;
+    };
+
+    /**
+     * @brief Compile a list of regexes
+     * @throws ParseException if a pattern is invalid
+     * @throws AutomataException if the set automaton exceeds Options::maxStates
+     */
+    explicit RegexSet(const std::vector<std::string>& patterns);
+    RegexSet(const std::vector<std::string>& patterns, const Options& options);
+
+    // Same, from already built automata (pattern i is dfas[i])
+    static RegexSet fromDFAs(const std::vector<DFA>& dfas);
+    static RegexSet fromDFAs(const std::vector<DFA>& dfas, const Options& options);
+
+    // Getters
+    size_t getPatternCount() const { return reverse_.size(); }
+    size_t getStateCount() const { return stateCount_; }
+    size_t getColumnCount() const { return columnCount_; }
+    const Options& getOptions() const { return options_; }
+
+    // Patterns accepted in a state of the set automaton, ascending
+    std::vector<size_t> getMatchingPatterns(Index state) const;
+
+    bool isMatch(const std::string& text) const;
+
+    // Indices of the patterns with at least one match in text, ascending
+    std::vector<size_t> matches(const std::string& text) const;
+
+    /**
+     * @brief Every match of every pattern, overlaps included
+     *
+     * Each pattern contributes the same pairs as
+     * DFASearcher(dfa, MatchKind::ALL_OVERLAPPING); results are sorted by
+     * start, end, then pattern.
+     */
+    std::vector<Match> findAll(const std::string& text) const;
+
+private:
+    Options options_;
+    std::array<uint8_t, 256> columns_;
+    size_t columnCount_;
+    unsigned strideShift_;
+    std::vector<Index> table_;            // stateCount_ rows of 2^strideShift_ entries
+    Index start_;
+    size_t stateCount_;
+    std::vector<uint32_t> matchStart_;    // CSR offsets into matchPatterns_, per state
+    std::vector<uint32_t> matchPatterns_;
+    std::vector<CompiledDFA> reverse_;    // Anchored reverse(L_i), for match starts
+
+    RegexSet();
+    void build(const std::vector<CompiledDFA>& dfas);
+
+    Index next(Index state, unsigned char byte) const {
+        return table_[(static_cast<size_t>(state) << strideShift_) | columns_[byte]];
+    }
+    bool isAccepting(Index state) const { return matchStart_[state] != matchStart_[state + 1]; }
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_REGEX_SET_HPP
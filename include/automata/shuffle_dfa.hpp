@@ -0,0 +1,103 @@
+#ifndef AUTOMATA_SHUFFLE_DFA_HPP
+#define AUTOMATA_SHUFFLE_DFA_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include "compiled_dfa.hpp"
+#include <array>
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Vectorized engine for DFAs with at most 16 states
+ *
+ * Every input column's transition function is stored as a 16-byte shuffle
+ * vector (entry s = successor of state s), so one state transition is a
+ * single PSHUFB with the current state as the index. Bit 0x40 of a state
+ * byte flags acceptance; the shuffle only looks at the low four bits, so
+ * the flag rides along for free and accept checks are batched per block.
+ *
+ * The AVX2 kernels run the two halves of the input in the two 128-bit
+ * lanes: the first lane follows the real state while the second follows
+ * all 16 states at once. run() composes the two at the end. findAccepting()
+ * trusts the second lane's accept flags once its live states have merged
+ * into one, and replays the steps before that; it needs the table of
+ * column pairs, so it is used when there are at most MAX_PAIR_COLUMNS
+ * columns. The backend is chosen at runtime from the CPU's features, with
+ * a scalar fallback.
+ */
+class ShuffleDFA {
+public:
+    static constexpr size_t MAX_STATES = 16;
+    static constexpr uint8_t ACCEPT_FLAG = 0x40;
+    static constexpr uint8_t STATE_MASK = 0x0f;
+    static constexpr size_t MAX_PAIR_COLUMNS = 16;  // Pair table up to 8 KB
+
+    enum class Backend { SCALAR, SSSE3, AVX2 };
+
+    ShuffleDFA();
+
+    // Whether an automaton is small enough for this engine
+    static bool fits(const CompiledDFA& dfa) { return dfa.getStateCount() <= MAX_STATES; }
+
+    /**
+     * @brief Build shuffle tables from a compiled DFA
+     * @throws std::invalid_argument if the DFA has more than 16 states
+     *         (including the dead state)
+     */
+    static ShuffleDFA fromCompiled(const CompiledDFA& dfa);
+    static ShuffleDFA fromDFA(const DFA& dfa);
+
+    // Best backend supported by the running CPU
+    static Backend detectBackend();
+    static std::string backendName(Backend backend);
+
+    Backend getBackend() const { return backend_; }
+    // Select a kernel; requests beyond what the CPU supports are lowered
+    void setBackend(Backend backend);
+
+    uint8_t getStartState() const { return start_; }
+    size_t getStateCount() const { return stateCount_; }
+
+    // Single transition on state bytes (flag included)
+    uint8_t next(uint8_t state, unsigned char byte) const {
+        return shuffles_[(static_cast<size_t>(columns_[byte]) << 4) | (state & STATE_MASK)];
+    }
+
+    static bool isAccepting(uint8_t state) { return (state & ACCEPT_FLAG) != 0; }
+    static bool isDead(uint8_t state) { return (state & STATE_MASK) == 0; }
+
+    /**
+     * @brief Run the automaton over a buffer
+     * @return State byte reached after consuming all of data
+     */
+    uint8_t run(uint8_t state, const char* data, size_t length) const;
+
+    // Acceptance testing
+    bool accepts(const std::string& input) const;
+    bool accepts(const char* data, size_t length) const;
+
+    /**
+     * @brief Collect every point at which the automaton is accepting
+     * @param backward Consume data from the last byte to the first
+     * @param positions Receives text offsets: forward, offset p means after
+     *        data[0, p) (ascending); backward, after data[p, length) read in
+     *        reverse (descending). The starting offset is included when the
+     *        start state accepts.
+     */
+    void findAccepting(const char* data, size_t length, bool backward, std::vector<size_t>& positions) const;
+
+private:
+    std::array<uint8_t, 256> columns_;
+    std::vector<uint8_t> shuffles_;  // 16 bytes per column
+    std::vector<uint8_t> pairs_;     // 32 bytes per column pair, for the AVX2 search kernel
+    uint8_t start_;
+    size_t stateCount_;
+    size_t columnCount_;
+    Backend backend_;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_SHUFFLE_DFA_HPP
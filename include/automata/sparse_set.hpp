@@ -0,0 +1,52 @@
+#ifndef AUTOMATA_SPARSE_SET_HPP
+#define AUTOMATA_SPARSE_SET_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace automata {
+
+/**
+ * @brief Briggs–Torczon sparse set of integers in [0, capacity)
+ *
+ * Membership test, insertion and clear are O(1) and iteration visits
+ * members in insertion order, so the set doubles as a work list. Storage
+ * is allocated once up front; nothing allocates afterwards.
+ */
+class SparseSet {
+public:
+    explicit SparseSet(size_t capacity = 0) : dense_(capacity), sparse_(capacity), size_(0) {}
+
+    size_t capacity() const { return dense_.size(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    bool contains(uint32_t value) const {
+        uint32_t i = sparse_[value];
+        return i < size_ && dense_[i] == value;
+    }
+
+    // Returns false if the value was already present
+    bool insert(uint32_t value) {
+        if (contains(value)) return false;
+        sparse_[value] = static_cast<uint32_t>(size_);
+        dense_[size_++] = value;
+        return true;
+    }
+
+    void clear() { size_ = 0; }
+
+    uint32_t operator[](size_t i) const { return dense_[i]; }
+    const uint32_t* begin() const { return dense_.data(); }
+    const uint32_t* end() const { return dense_.data() + size_; }
+
+private:
+    std::vector<uint32_t> dense_;
+    std::vector<uint32_t> sparse_;
+    size_t size_;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_SPARSE_SET_HPP
@@ -0,0 +1,89 @@
+#ifndef AUTOMATA_STREAM_MATCHER_HPP
+#define AUTOMATA_STREAM_MATCHER_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include "compiled_dfa.hpp"
+#include "shuffle_dfa.hpp"
+
+namespace automata {
+
+/**
+ * @brief Incremental DFA search over input that arrives in chunks
+ *
+ * Chunks of any size are fed in order; matches are reported through a
+ * callback with offsets relative to the start of the stream, with the same
+ * results as DFASearcher over the concatenated input.
+ *
+ * After each chunk the matcher keeps only a carry-over: the text from the
+ * earliest position where a match could still start, i.e. where the text
+ * up to the current end is still a prefix of some match. That position is
+ * found with an anchored scan backwards from the end over the reversed
+ * prefix language, which stops as soon as no longer suffix can be a match
+ * prefix. Everything before it is final and is reported and dropped, so
+ * memory stays bounded by the longest open match rather than the stream.
+ * Patterns with unbounded repetition can keep a match open indefinitely;
+ * Options::maxCarryBytes caps the carry-over for them.
+ *
+ *  - LEFTMOST_LONGEST / LEFTMOST_SHORTEST: each chunk runs the backward
+ *    Σ*·reverse(L) pass over carry-over plus chunk (on ShuffleDFA when it
+ *    fits), and a match is reported once its start lies before every open
+ *    position.
+ *  - ALL_OVERLAPPING: the forward Σ*L state persists across chunks and
+ *    every match is reported when its end arrives (starts ascending per end).
+ */
+class StreamMatcher {
+public:
+    using Callback = std::function<void(size_t start, size_t end)>;
+
+    struct Options {
+        size_t maxCarryBytes = 64 << 20;  // Carry-over size beyond which feed() throws
+    };
+
+    StreamMatcher(const DFA& dfa, MatchKind kind, Callback onMatch);
+    StreamMatcher(const DFA& dfa, MatchKind kind, Callback onMatch, const Options& options);
+
+    /**
+     * @brief Consume the next chunk, reporting every match that became final
+     * @throws AutomataException if the carry-over exceeds Options::maxCarryBytes
+     */
+    void feed(const char* data, size_t length);
+    void feed(const std::string& chunk) { feed(chunk.data(), chunk.size()); }
+
+    // End of stream: report the remaining matches and start a new stream
+    void finish();
+
+    // Drop all state without reporting anything further
+    void reset();
+
+    // Bytes consumed in the current stream
+    size_t getOffset() const { return base_ + buffer_.size(); }
+    size_t getCarrySize() const { return buffer_.size(); }
+    MatchKind getMatchKind() const { return kind_; }
+
+private:
+    MatchKind kind_;
+    Callback onMatch_;
+    Options options_;
+    CompiledDFA forward_;        // Σ*L for ALL_OVERLAPPING, otherwise L
+    CompiledDFA reverse_;        // reverse(L) for ALL_OVERLAPPING, otherwise Σ*·reverse(L)
+    CompiledDFA openPrefixes_;   // reverse(Pref(L)), anchored: finds open positions
+    std::optional<ShuffleDFA> scanner_;  // Vectorized backward pass, if small enough
+
+    std::string buffer_;         // Carry-over followed by the current chunk
+    size_t base_;                // Stream offset of buffer_[0]
+    CompiledDFA::Index state_;   // Σ*L state at the end of buffer_ (ALL_OVERLAPPING)
+    bool started_;
+    std::vector<size_t> starts_;  // Scratch: match starts
+
+    void process(size_t fresh, bool final);
+    // Report final leftmost matches; returns where the search resumes
+    size_t reportLeftmost(size_t firstOpen);
+    void reportEnding(size_t end);
+    // Smallest buffer position p whose suffix buffer_[p..] is a match prefix
+    size_t firstOpenPosition() const;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_STREAM_MATCHER_HPP
@@ -0,0 +1,92 @@
+#ifndef AUTOMATA_STRIDED_DFA_HPP
+#define AUTOMATA_STRIDED_DFA_HPP
+
+#include "common.hpp"
+#include "dfa.hpp"
+#include "compiled_dfa.hpp"
+#include <array>
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Multi-stride DFA over the 2-bit DNA alphabet
+ *
+ * Each transition consumes k bases at once (k = 1, 2 or 4), indexed by the
+ * k bases packed two bits apiece (A=0, C=1, G=2, T=3), giving 4^k columns
+ * per state. Every table entry holds the target state shifted left by four
+ * plus a mask whose bit i says the automaton accepted after base i + 1 of
+ * the stride, so accept positions inside a stride are still exact.
+ *
+ * Groups containing any byte other than uppercase A/C/G/T are consumed one
+ * byte at a time through the underlying CompiledDFA, so results are always
+ * identical to the single-step automaton.
+ */
+class StridedDFA {
+public:
+    using Index = CompiledDFA::Index;
+
+    static constexpr size_t MAX_TABLE_BYTES = 1 << 20;  // Largest table fits() accepts
+
+    StridedDFA();
+
+    /**
+     * @brief Whether striding pays off for an automaton
+     *
+     * True when the automaton reads only A, C, G and T (every other byte is
+     * in the never-used column 0) and its stride-k table is at most
+     * MAX_TABLE_BYTES.
+     */
+    static bool fits(const CompiledDFA& dfa, unsigned stride);
+
+    /**
+     * @brief Compile a stride-k table
+     * @param dfa Single-step automaton (e.g. CompiledDFA::unanchored() to find match ends)
+     * @param stride Bases per transition: 1, 2 or 4
+     * @throws std::invalid_argument for any other stride
+     */
+    static StridedDFA fromCompiled(const CompiledDFA& dfa, unsigned stride);
+    static StridedDFA fromDFA(const DFA& dfa, unsigned stride);
+
+    // Getters
+    unsigned getStride() const { return stride_; }
+    Index getStartState() const { return base_.getStartState(); }
+    const CompiledDFA& getBase() const { return base_; }
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Run the automaton over a buffer
+     * @return State reached after consuming all of data (DEAD if it died)
+     */
+    Index run(Index state, const char* data, size_t length) const;
+
+    // Acceptance testing
+    bool accepts(const std::string& input) const;
+    bool accepts(const char* data, size_t length) const;
+
+    /**
+     * @brief Collect every point at which the automaton is accepting
+     * @param backward Consume data from the last byte to the first
+     * @param positions Receives text offsets as in ShuffleDFA::findAccepting:
+     *        forward, offset p means after data[0, p) (ascending); backward,
+     *        after data[p, length) read in reverse (descending). The starting
+     *        offset is included when the start state accepts.
+     */
+    void findAccepting(const char* data, size_t length, bool backward, std::vector<size_t>& positions) const;
+
+private:
+    static constexpr uint8_t NOT_DNA = 0xff;
+
+    template <bool Backward>
+    void collectAccepting(const unsigned char* bytes, size_t length, std::vector<size_t>& positions) const;
+
+    CompiledDFA base_;
+    std::array<uint8_t, 256> codes_;  // 2-bit base code, or NOT_DNA
+    std::vector<uint32_t> table_;     // (target << 4) | accept mask
+    unsigned stride_;
+    unsigned shift_;                  // 2 * stride
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_STRIDED_DFA_HPP
@@ -0,0 +1,92 @@
+#ifndef AUTOMATA_SYMBOL_SET_HPP
+#define AUTOMATA_SYMBOL_SET_HPP
+
+#include "common.hpp"
+#include <array>
+#include <cstdint>
+
+namespace automata {
+
+/**
+ * @brief Set of input symbols as a 256-bit bitmap
+ *
+ * Labels a character-class transition. EPSILON (byte 0) is never a member,
+ * so a class edge always consumes input.
+ */
+class SymbolSet {
+public:
+    using Bits = std::array<uint64_t, 4>;
+
+    SymbolSet() : bits_{} {}
+
+    void add(Symbol s) {
+        auto b = static_cast<unsigned char>(s);
+        if (b != 0) bits_[b >> 6] |= uint64_t{1} << (b & 63);
+    }
+
+    void addRange(Symbol lo, Symbol hi) {
+        for (int b = static_cast<unsigned char>(lo); b <= static_cast<unsigned char>(hi); ++b) {
+            add(static_cast<Symbol>(b));
+        }
+    }
+
+    void remove(Symbol s) {
+        auto b = static_cast<unsigned char>(s);
+        bits_[b >> 6] &= ~(uint64_t{1} << (b & 63));
+    }
+
+    bool contains(Symbol s) const {
+        auto b = static_cast<unsigned char>(s);
+        return (bits_[b >> 6] >> (b & 63)) & 1;
+    }
+
+    size_t size() const {
+        size_t n = 0;
+        for (uint64_t w : bits_) n += static_cast<size_t>(__builtin_popcountll(w));
+        return n;
+    }
+
+    bool empty() const { return (bits_[0] | bits_[1] | bits_[2] | bits_[3]) == 0; }
+
+    // Members in byte order
+    std::vector<Symbol> members() const {
+        std::vector<Symbol> result;
+        for (int b = 1; b < 256; ++b) {
+            if (contains(static_cast<Symbol>(b))) result.push_back(static_cast<Symbol>(b));
+        }
+        return result;
+    }
+
+    const Bits& getBits() const { return bits_; }
+
+    bool operator==(const SymbolSet& other) const { return bits_ == other.bits_; }
+    bool operator!=(const SymbolSet& other) const { return bits_ != other.bits_; }
+    bool operator<(const SymbolSet& other) const { return bits_ < other.bits_; }
+
+    // Bracket notation with runs of three or more collapsed, e.g. "[ACGT]", "[ -~]"
+    std::string toString() const {
+        std::string result = "[";
+        int b = 1;
+        while (b < 256) {
+            if (!contains(static_cast<Symbol>(b))) { ++b; continue; }
+            int run = b;
+            while (run + 1 < 256 && contains(static_cast<Symbol>(run + 1))) ++run;
+            result += static_cast<char>(b);
+            if (run - b >= 2) {
+                result += '-';
+                result += static_cast<char>(run);
+            } else if (run > b) {
+                result += static_cast<char>(run);
+            }
+            b = run + 1;
+        }
+        return result + "]";
+    }
+
+private:
+    Bits bits_;
+};
+
+} // namespace automata
+
+#endif // AUTOMATA_SYMBOL_SET_HPP
@@ -2,6 +2,7 @@
 #define AUTOMATA_TRANSITION_HPP
 
 #include "common.hpp"
+#include "symbol_set.hpp"
 
 namespace automata {
 
@@ -9,7 +10,9 @@ namespace automata {
  * @brief Represents a transition in a finite automaton
  * 
  * A transition connects a source state to a destination state on a given symbol.
- * Epsilon transitions use the EPSILON constant as the symbol.
+ * Epsilon transitions use the EPSILON constant as the symbol. A class
+ * transition is labelled with a whole SymbolSet (e.g. `[ACGT]` or `.`) and
+ * is taken on any of its members; the set is shared between copies.
  */
 class Transition {
 public:
@@ -21,14 +24,35 @@ public:
      */
     Transition(StateId from, StateId to, Symbol symbol);
     
+    /**
+     * @brief Construct a class transition
+     * @param symbols Non-empty set of symbols the edge accepts
+     */
+    Transition(StateId from, StateId to, const SymbolSet& symbols);
+    
     // Getters
     StateId getFrom() const { return from_; }
     StateId getTo() const { return to_; }
+    // For class transitions: the smallest member
     Symbol getSymbol() const { return symbol_; }
     
     // Check if this is an epsilon transition
     bool isEpsilon() const { return symbol_ == EPSILON; }
     
+    // Class transitions
+    bool isClass() const { return symbols_ != nullptr; }
+    // Symbols the edge is taken on (empty for epsilon)
+    SymbolSet getSymbols() const;
+    bool matches(Symbol symbol) const {
+        return symbols_ ? symbols_->contains(symbol) : (symbol_ == symbol && symbol != EPSILON);
+    }
+    
+    // Same label between other endpoints
+    Transition withEndpoints(StateId from, StateId to) const;
+    
+    // Display label: symbol, "ε", or bracketed class
+    std::string getLabel() const;
+    
     // For use in sets/maps
     bool operator<(const Transition& other) const;
     bool operator==(const Transition& other) const;
@@ -43,6 +67,7 @@ private:
     StateId from_;
     StateId to_;
     Symbol symbol_;
+    std::shared_ptr<const SymbolSet> symbols_;  // Set only for class transitions
 };
 
 /**
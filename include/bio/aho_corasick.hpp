@@ -0,0 +1,100 @@
+#ifndef BIO_AHO_CORASICK_HPP
+#define BIO_AHO_CORASICK_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace bio {
+
+/**
+ * @brief Aho–Corasick automaton for searching a panel of DNA literals at once
+ *
+ * The keyword trie is stored as a dense goto table with one column per base
+ * (plus one for any other byte, which returns to the root). Failure links
+ * are resolved while building, so the table is a complete DFA and scanning
+ * costs one load per base regardless of the panel size. Each state keeps the
+ * list of patterns ending exactly there and a link to the nearest suffix
+ * state that also ends a pattern, so reporting is proportional to the
+ * number of matches. Table entries leading to such states carry a flag bit,
+ * which keeps the check off the common path.
+ *
+ * Patterns and text are case-insensitive; bytes other than A, C, G and T
+ * (e.g. N) never take part in a match.
+ */
+class AhoCorasick {
+public:
+    using StateIndex = uint32_t;
+
+    struct Match {
+        size_t start;
+        size_t end;            // Exclusive
+        size_t patternIndex;   // Position in the constructor's list
+    };
+
+    /**
+     * @brief Build the automaton for a panel of literals
+     * @param patterns DNA literals; duplicates are allowed and reported separately
+     * @throws std::invalid_argument if a pattern is empty or contains non-ACGT characters
+     */
+    explicit AhoCorasick(const std::vector<std::string>& patterns);
+
+    // Getters
+    size_t getPatternCount() const { return patternLengths_.size(); }
+    size_t getPatternLength(size_t index) const { return patternLengths_[index]; }
+    size_t getStateCount() const { return dictionaryLink_.size(); }
+
+    /**
+     * @brief Every occurrence of every pattern, overlaps included
+     *
+     * Ordered by end position; matches ending at the same position are
+     * reported longest first, then in pattern order.
+     */
+    std::vector<Match> findAll(const std::string& text) const;
+
+    // Number of occurrences of each pattern
+    std::vector<size_t> countAll(const std::string& text) const;
+
+    /**
+     * @brief Single pass over a buffer with a callback
+     * @param onMatch Called as onMatch(patternIndex, end) for every occurrence
+     */
+    template <typename Callback>
+    void scan(const char* data, size_t length, Callback&& onMatch) const;
+
+private:
+    static constexpr size_t COLUMNS = 5;  // A, C, G, T, other
+    static constexpr StateIndex ROOT = 0;
+    static constexpr StateIndex NONE = UINT32_MAX;
+    static constexpr StateIndex OUTPUT_FLAG = 0x80000000u;
+    static constexpr StateIndex STATE_MASK = 0x7fffffffu;
+
+    static const std::array<uint8_t, 256>& codes();
+
+    std::vector<StateIndex> table_;           // states x COLUMNS, flag in bit 31
+    std::vector<StateIndex> dictionaryLink_;  // Nearest proper suffix with output, or NONE
+    std::vector<uint32_t> outputStart_;       // CSR offsets into outputs_
+    std::vector<uint32_t> outputs_;           // Patterns ending exactly at each state
+    std::vector<size_t> patternLengths_;
+};
+
+template <typename Callback>
+void AhoCorasick::scan(const char* data, size_t length, Callback&& onMatch) const {
+    const std::array<uint8_t, 256>& code = codes();
+    StateIndex state = ROOT;
+    for (size_t i = 0; i < length; ++i) {
+        StateIndex entry = table_[static_cast<size_t>(state) * COLUMNS + code[static_cast<unsigned char>(data[i])]];
+        state = entry & STATE_MASK;
+        if (entry & OUTPUT_FLAG) {
+            for (StateIndex s = state; s != NONE; s = dictionaryLink_[s]) {
+                for (uint32_t k = outputStart_[s]; k < outputStart_[s + 1]; ++k) onMatch(outputs_[k], i + 1);
+            }
+        }
+    }
+}
+
+} // namespace bio
+
+#endif // BIO_AHO_CORASICK_HPP
@@ -9,6 +9,9 @@
 
 namespace bio {
 
+class MyersMatcher;
+class KmerIndex;
+
 /**
  * @brief Approximate pattern matching using Levenshtein automaton
  * 
@@ -28,6 +31,24 @@ public:
         ALL = 7             // All edit types
     };
     
+    /**
+     * @brief Search algorithm used by findAll
+     * 
+     * Every strategy reports the same matches. With all edit types allowed,
+     * AUTO picks SEED_AND_VERIFY when the pattern is ACGT and splits into
+     * k + 1 pieces of at least 8 bases, and BIT_VECTOR otherwise; with
+     * restricted edit types it picks NFA_SIMULATION.
+     */
+    enum class Strategy {
+        AUTO,
+        NFA_SIMULATION,     // Levenshtein NFA stepped from every start
+        BIT_VECTOR,         // Myers' bit-parallel DP; requires EditType::ALL
+        UNIVERSAL_AUTOMATON,// Universal Levenshtein DFA walked from every start;
+                            // requires EditType::ALL and maxDistance <= 3
+        SEED_AND_VERIFY     // Exact hits of k + 1 pattern pieces, verified with
+                            // BIT_VECTOR around each; requires EditType::ALL
+    };
+    
     /**
      * @brief Construct approximate matcher
      * @param pattern The pattern to match
@@ -41,6 +62,14 @@ public:
     // Getters
     const std::string& getPattern() const { return pattern_; }
     int getMaxDistance() const { return maxDistance_; }
+    Strategy getStrategy() const { return strategy_; }
+    
+    /**
+     * @brief Select the search algorithm
+     * @throws std::invalid_argument if the strategy does not support this
+     *         matcher's edit types or distance
+     */
+    void setStrategy(Strategy strategy);
     
     /**
      * @brief Build NFA for approximate matching
@@ -52,17 +81,24 @@ public:
     
     /**
      * @brief Build DFA for faster matching (may have exponential states)
+     * 
+     * With all edit types and maxDistance <= 3 the DFA is instantiated from
+     * the universal Levenshtein automaton (at most |U|·(m+1) states, no
+     * subset construction); otherwise the NFA is determinized.
      */
     automata::DFA buildDFA() const;
     
     /**
      * @brief Check if text matches pattern within edit distance
+     * 
+     * Walks the universal Levenshtein automaton when buildDFA() would use it.
      */
     bool matches(const std::string& text) const;
     
     /**
      * @brief Find all approximate matches in text
-     * @return Vector of (start, end, editDistance) tuples
+     * @return Every substring within maxDistance of the pattern (using the
+     *         allowed edit types), ordered by start, then end
      */
     struct Match {
         size_t start;
@@ -72,13 +108,35 @@ public:
     };
     std::vector<Match> findAll(const std::string& text) const;
     
+    /**
+     * @brief findAll() seeded from a prebuilt index of text
+     * 
+     * Looks up the k + 1 pigeonhole pieces of the pattern in the index and
+     * verifies only the windows around their occurrences, so repeated
+     * queries against one reference skip the full scan. Falls back to
+     * findAll(text) when the pieces are shorter than the index's k-mers or
+     * the pattern cannot be seeded.
+     * @throws std::invalid_argument if the index was built for another length
+     */
+    std::vector<Match> findAll(const std::string& text, const KmerIndex& index) const;
+    
     /**
      * @brief Compute edit distance between two strings
      */
     static int editDistance(const std::string& s1, const std::string& s2);
     
+    /**
+     * @brief Edit distance if it is at most maxDistance, else maxDistance + 1
+     * 
+     * Only fills the diagonal band of width 2·maxDistance + 1 and stops once
+     * a whole row of it exceeds maxDistance.
+     */
+    static int editDistance(const std::string& s1, const std::string& s2, int maxDistance);
+    
     /**
      * @brief Get edit operations to transform s1 to s2
+     * 
+     * Linear space (Hirschberg) for long pairs; see EditDistance::alignment().
      */
     struct EditOperation {
         enum Type { MATCH, SUBSTITUTE, INSERT, DELETE } type;
@@ -90,14 +148,41 @@ public:
     // JSON serialization of matches
     std::string matchesToJson(const std::vector<Match>& matches) const;
 
+protected:
+    // Whether the NFA can consume c at all; matches never span other bytes
+    bool isInAlphabet(char c) const { return inAlphabet_[static_cast<unsigned char>(c)]; }
+
 private:
     std::string pattern_;
     int maxDistance_;
     int editTypes_;
+    Strategy strategy_;
     std::set<char> alphabet_;
+    bool inAlphabet_[256];      // Byte lookup for alphabet_
     
     void buildAlphabet();
     
+    // Whether the universal Levenshtein automaton covers this matcher
+    bool hasUniversalAutomaton() const;
+    
+    // findAll backends
+    std::vector<Match> findAllNFA(const std::string& text) const;
+    std::vector<Match> findAllBitVector(const std::string& text) const;
+    std::vector<Match> findAllUniversal(const std::string& text) const;
+    std::vector<Match> findAllSeeded(const std::string& text) const;
+    
+    // Seed-and-verify: pieces as (pattern offset, literal), and whether
+    // they apply (all edit types, ACGT pattern of at least k + 1 letters)
+    std::vector<std::pair<size_t, std::string>> pigeonholeSeeds() const;
+    bool canSeed() const;
+    std::vector<Match> verifySeedHits(const std::string& text,
+                                      std::vector<std::pair<size_t, size_t>>& windows) const;
+    
+    // Bit-vector matches lying entirely within text[begin, end)
+    void verifyWindow(const MyersMatcher& myers, const std::string& text,
+                      size_t begin, size_t end, std::vector<Match>& matches) const;
+    static void sortMatches(std::vector<Match>& matches);
+    
     // NFA state encoding: (pattern_position, edit_count)
     automata::StateId encodeState(int pos, int edits) const;
     std::pair<int, int> decodeState(automata::StateId id) const;
@@ -114,6 +199,10 @@ public:
     
     /**
      * @brief Find all approximate matches in a DNA sequence
+     * 
+     * Same matches as findAll() (windows of the pattern's length with at
+     * most maxMismatches substitutions, reported with their edit distance),
+     * found with the bit-parallel HammingMatcher instead of the NFA.
      */
     std::vector<Match> findInSequence(const Sequence& seq) const;
     
@@ -0,0 +1,68 @@
+#ifndef BIO_EDIT_DISTANCE_HPP
+#define BIO_EDIT_DISTANCE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bio {
+
+/**
+ * @brief Levenshtein distance and alignment kernels
+ *
+ * distance() keeps only the last two anti-diagonals of the DP table. Cells
+ * on one anti-diagonal do not depend on each other, so for long pairs they
+ * are computed 8 (SSE4.1) or 16 (AVX2) at a time in 16-bit lanes.
+ *
+ * bounded() is Ukkonen's cut-off. When the distance only matters up to k,
+ * just the diagonal band |i - j| <= k is filled, and the scan stops as soon
+ * as a whole row of the band exceeds k. It takes O(k·min(m, n)) time.
+ *
+ * alignment() returns an optimal edit script in linear space. Hirschberg's
+ * algorithm splits the first string in half and finds where an optimal
+ * path crosses the middle row, using a forward and a backward DP row. It
+ * then recurses until a subproblem has at most MAX_TRACEBACK_CELLS cells,
+ * which is traced back from a full table.
+ */
+class EditDistance {
+public:
+    enum class Backend { SCALAR, SSE41, AVX2 };
+
+    // One column of an alignment of a against b
+    enum class Op : uint8_t {
+        MATCH,          // a[i] == b[j]
+        SUBSTITUTE,     // a[i] replaced by b[j]
+        INSERT,         // b[j] inserted
+        DELETE          // a[i] deleted
+    };
+
+    // Shorter pairs are not worth the vector setup
+    static constexpr size_t MIN_SIMD_LENGTH = 32;
+    static constexpr size_t MAX_TRACEBACK_CELLS = size_t{1} << 20;
+
+    static Backend detectBackend();
+
+    static int distance(const std::string& a, const std::string& b);
+    // Requests beyond what the CPU supports are lowered
+    static int distance(const char* a, size_t m, const char* b, size_t n, Backend backend);
+
+    /**
+     * @brief Distance if it is at most k
+     * @return The distance, or k + 1 if it exceeds k
+     */
+    static int bounded(const std::string& a, const std::string& b, int k);
+    static int bounded(const char* a, size_t m, const char* b, size_t n, int k);
+
+    /**
+     * @brief Optimal edit script turning a into b
+     *
+     * Pairs small enough for one traceback table give the same script as
+     * the textbook backtrack (match, then substitution, then insertion,
+     * then deletion, from the end).
+     */
+    static std::vector<Op> alignment(const std::string& a, const std::string& b);
+};
+
+} // namespace bio
+
+#endif // BIO_EDIT_DISTANCE_HPP
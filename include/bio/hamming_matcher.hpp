@@ -0,0 +1,62 @@
+#ifndef BIO_HAMMING_MATCHER_HPP
+#define BIO_HAMMING_MATCHER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bio {
+
+/**
+ * @brief Bit-parallel k-mismatch search
+ *
+ * The text is split into one-hot bitplanes, one per distinct pattern letter:
+ * bit i of plane c is set when text[i] == c. For a block of start positions
+ * s, bit s of plane pattern[j] shifted down by j says whether offset j
+ * matches, so one word operation handles 64 starts (256 with AVX2). The
+ * mismatches are summed with a bit-sliced counter (Shift-Add). It is
+ * preloaded so that it carries out exactly when a start exceeds k
+ * mismatches, and a block stops early once every start has.
+ *
+ * Letters are compared byte for byte, so N or lowercase in the text only
+ * ever mismatch; every window of the pattern's length is a candidate.
+ */
+class HammingMatcher {
+public:
+    enum class Backend { SCALAR, AVX2 };
+
+    struct Hit {
+        size_t start;
+        int mismatches;
+    };
+
+    /**
+     * @param maxMismatches Largest reported Hamming distance; negative matches nothing
+     * @throws std::invalid_argument if the pattern is empty
+     */
+    HammingMatcher(const std::string& pattern, int maxMismatches);
+
+    static Backend detectBackend();
+    Backend getBackend() const { return backend_; }
+    // Select a kernel; requests beyond what the CPU supports are lowered
+    void setBackend(Backend backend);
+
+    const std::string& getPattern() const { return pattern_; }
+    int getMaxMismatches() const { return maxMismatches_; }
+
+    // Every window within maxMismatches of the pattern, by start
+    std::vector<Hit> findAll(const char* text, size_t length) const;
+    std::vector<Hit> findAll(const std::string& text) const { return findAll(text.data(), text.size()); }
+
+private:
+    std::string pattern_;
+    int maxMismatches_;
+    Backend backend_;
+    int counterBits_;               // Bits per bit-sliced counter, enough for k + 1
+    std::vector<uint8_t> letters_;  // Distinct pattern letters; plane index = position here
+    std::vector<uint8_t> planeOf_;  // Pattern offset -> plane
+};
+
+} // namespace bio
+
+#endif // BIO_HAMMING_MATCHER_HPP
@@ -0,0 +1,53 @@
+#ifndef BIO_KMER_INDEX_HPP
+#define BIO_KMER_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bio {
+
+/**
+ * @brief Positions of every k-mer of a DNA reference
+ *
+ * Each k-mer is packed 2 bits per base into a bucket number. Positions are
+ * stored in CSR form: a prefix-sum array over all 4^k buckets and one
+ * position array sorted by bucket, then by position. Building takes two
+ * passes over the reference; a lookup is two loads. The index does not
+ * keep the reference, and it is meant to be built once and reused for many
+ * queries (see ApproximateMatcher::findAll(text, index)).
+ *
+ * Bases are case-insensitive like AhoCorasick; a k-mer containing any
+ * other byte (e.g. N) is not indexed.
+ */
+class KmerIndex {
+public:
+    static constexpr int DEFAULT_K = 12;
+    static constexpr int MAX_K = 14;
+
+    using Range = std::pair<const uint32_t*, const uint32_t*>;
+
+    explicit KmerIndex(const std::string& reference);
+    /**
+     * @throws std::invalid_argument unless 1 <= k <= MAX_K, or if the
+     *         reference does not fit 32-bit positions
+     */
+    KmerIndex(const std::string& reference, int k);
+
+    int getK() const { return k_; }
+    size_t getReferenceLength() const { return referenceLength_; }
+
+    // Ascending start positions of the k bases at kmer; empty if they are not all ACGT
+    Range lookup(const char* kmer) const;
+
+private:
+    int k_;
+    size_t referenceLength_;
+    std::vector<uint32_t> bucketStart_;  // 4^k + 1 offsets into positions_
+    std::vector<uint32_t> positions_;
+};
+
+} // namespace bio
+
+#endif // BIO_KMER_INDEX_HPP
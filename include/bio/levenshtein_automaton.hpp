@@ -0,0 +1,123 @@
+#ifndef BIO_LEVENSHTEIN_AUTOMATON_HPP
+#define BIO_LEVENSHTEIN_AUTOMATON_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bio {
+
+/**
+ * @brief Schulz–Mihov universal Levenshtein automaton for one distance k
+ *
+ * A deterministic automaton that does not depend on the pattern. Its states
+ * are the subsumption-reduced sets of Levenshtein NFA positions (i, e),
+ * stored relative to the smallest pattern offset i (the "base"). Its input
+ * is not a letter but the characteristic vector of that letter against the
+ * pattern window starting at the base: bit j is set when pattern[base + j]
+ * equals the letter. Each transition also reports how far the base moves.
+ *
+ * The automaton is built once per k and shared by every pattern, so a
+ * pattern needs no NFA construction or determinization, and the table size
+ * does not depend on the alphabet.
+ */
+class UniversalLevenshtein {
+public:
+    using State = uint32_t;
+    static constexpr State DEAD = 0;
+    static constexpr int MAX_DISTANCE = 3;
+
+    /**
+     * @brief Shared automaton for distance k, built on first use
+     * @throws std::invalid_argument unless 0 <= k <= MAX_DISTANCE
+     */
+    static const UniversalLevenshtein& forDistance(int k);
+
+    int getMaxDistance() const { return k_; }
+    // Number of pattern characters each characteristic vector covers
+    int getWindow() const { return window_; }
+    size_t getStateCount() const { return shifts_.size() / (size_t{1} << window_); }
+    State getStartState() const { return 1; }
+
+    State next(State state, uint32_t vector) const { return next_[(state << window_) | vector]; }
+    // How far the base moves along the pattern on that transition
+    uint32_t shift(State state, uint32_t vector) const { return shifts_[(state << window_) | vector]; }
+
+    /**
+     * @brief Edit distance represented by a state
+     * @param remaining Pattern characters from the base to the pattern end
+     * @return The distance, or k + 1 if it exceeds k
+     */
+    int distance(State state, size_t remaining) const {
+        return remaining < reach_ ? distances_[state * reach_ + remaining] : k_ + 1;
+    }
+
+private:
+    int k_;
+    int window_;
+    size_t reach_;                  // Remaining lengths with a distance <= k are below this
+    std::vector<State> next_;       // State x vector
+    std::vector<uint8_t> shifts_;   // State x vector
+    std::vector<uint8_t> distances_;  // State x remaining
+
+    explicit UniversalLevenshtein(int k);
+};
+
+/**
+ * @brief Levenshtein automaton of one pattern, run on the universal table
+ *
+ * Only the per-letter position masks of the pattern are computed; each step
+ * extracts the characteristic vector at the current base and follows the
+ * shared table. Accepts exactly the strings within k edits of the pattern.
+ */
+class LevenshteinDFA {
+public:
+    struct Cursor {
+        UniversalLevenshtein::State state;
+        size_t base;    // Pattern offset the state is relative to
+    };
+
+    /**
+     * @throws std::invalid_argument unless 0 <= k <= UniversalLevenshtein::MAX_DISTANCE
+     */
+    LevenshteinDFA(const std::string& pattern, int k);
+
+    Cursor start() const { return {automaton_->getStartState(), 0}; }
+
+    Cursor next(Cursor cursor, char c) const {
+        const uint32_t vector = characteristicVector(c, cursor.base);
+        return {automaton_->next(cursor.state, vector), cursor.base + automaton_->shift(cursor.state, vector)};
+    }
+
+    static bool isDead(Cursor cursor) { return cursor.state == UniversalLevenshtein::DEAD; }
+
+    // Distance of the text read so far, or k + 1 if it exceeds k
+    int distance(Cursor cursor) const {
+        return automaton_->distance(cursor.state, cursor.base < length_ ? length_ - cursor.base : 0);
+    }
+    bool isAccepting(Cursor cursor) const { return distance(cursor) <= automaton_->getMaxDistance(); }
+
+    bool accepts(const std::string& text) const;
+
+    const UniversalLevenshtein& getAutomaton() const { return *automaton_; }
+
+private:
+    const UniversalLevenshtein* automaton_;
+    size_t length_;
+    size_t words_;                  // Words per mask, with one word of padding
+    uint16_t maskIndex_[256];       // Letter -> mask, 0 for letters absent from the pattern
+    std::vector<uint64_t> masks_;   // Bit i set where pattern[i] is the letter
+
+    uint32_t characteristicVector(char c, size_t base) const {
+        const uint64_t* mask = masks_.data() + maskIndex_[static_cast<unsigned char>(c)] * words_;
+        const size_t word = base / 64;
+        const unsigned bit = base % 64;
+        uint64_t bits = mask[word] >> bit;
+        if (bit != 0) bits |= mask[word + 1] << (64 - bit);
+        return static_cast<uint32_t>(bits & ((uint64_t{1} << automaton_->getWindow()) - 1));
+    }
+};
+
+} // namespace bio
+
+#endif // BIO_LEVENSHTEIN_AUTOMATON_HPP
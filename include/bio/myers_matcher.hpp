@@ -0,0 +1,63 @@
+#ifndef BIO_MYERS_MATCHER_HPP
+#define BIO_MYERS_MATCHER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bio {
+
+/**
+ * @brief Myers' bit-vector algorithm for approximate (Levenshtein) search
+ *
+ * One column of the edit-distance DP table is kept as vertical +1/-1 delta
+ * bit-vectors, so a text character advances 64 pattern rows with a handful
+ * of word operations. Patterns longer than 64 use ⌈m/64⌉ blocks chained by
+ * their horizontal delta at the block boundary (Hyyrö's formulation), for
+ * O(n·⌈m/64⌉) search.
+ *
+ * findEnds() runs the semi-global variant (a match may start anywhere) and
+ * reports every end position whose best match is within k edits.
+ * distancesEndingAt() runs the global variant backwards from one end with
+ * the reversed pattern, giving the exact distance for every start, which is
+ * how start positions are recovered.
+ */
+class MyersMatcher {
+public:
+    struct End {
+        size_t end;     // Exclusive text position
+        int distance;   // Least distance of a substring ending here
+    };
+
+    /**
+     * @param pattern Pattern to search for; matched byte for byte
+     * @throws std::invalid_argument if the pattern is empty
+     */
+    explicit MyersMatcher(const std::string& pattern);
+
+    size_t getPatternLength() const { return length_; }
+    size_t getWordCount() const { return words_; }
+
+    // Every end position where some substring ending there is within k edits
+    std::vector<End> findEnds(const char* text, size_t length, int k) const;
+
+    /**
+     * @brief Distances of all substrings ending at a position
+     * @param distances Receives distances[len] = lev(pattern, text[end - len, end))
+     *        for len = 0 .. min(maxLength, end)
+     */
+    void distancesEndingAt(const char* text, size_t end, size_t maxLength, std::vector<int>& distances) const;
+
+private:
+    size_t length_;
+    size_t words_;
+    std::vector<uint64_t> peq_;         // 256 x words_: bit i set where pattern[i] == c
+    std::vector<uint64_t> peqReverse_;  // Same for the reversed pattern
+
+    // Advance all blocks over one character; returns the change of the last row
+    int advance(const uint64_t* eq, uint64_t* pv, uint64_t* mv, int carryIn) const;
+};
+
+} // namespace bio
+
+#endif // BIO_MYERS_MATCHER_HPP
@@ -0,0 +1,143 @@
+#include "bio/aho_corasick.hpp"
+
+namespace bio {
+
+const std::array<uint8_t, 256>& AhoCorasick::codes() {
+    static const std::array<uint8_t, 256> table = [] {
+        std::array<uint8_t, 256> t;
+        t.fill(4);
+        t['A'] = t['a'] = 0;
+        t['C'] = t['c'] = 1;
+        t['G'] = t['g'] = 2;
+        t['T'] = t['t'] = 3;
+        return t;
+    }();
+    return table;
+}
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& patterns) {
+    const std::array<uint8_t, 256>& code = codes();
+
+    // Keyword trie; missing edges are NONE until failure links fill them in
+    table_.assign(COLUMNS, NONE);
+    std::vector<StateIndex> patternState;
+    patternState.reserve(patterns.size());
+    patternLengths_.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+        if (pattern.empty()) {
+            throw std::invalid_argument("Empty pattern in Aho-Corasick panel");
+        }
+        StateIndex state = ROOT;
+        for (char c : pattern) {
+            uint8_t column = code[static_cast<unsigned char>(c)];
+            if (column >= 4) {
+                throw std::invalid_argument("Invalid characters in pattern: " + pattern);
+            }
+            StateIndex& next = table_[static_cast<size_t>(state) * COLUMNS + column];
+            if (next == NONE) {
+                size_t created = table_.size() / COLUMNS;
+                if (created > STATE_MASK) {
+                    throw std::invalid_argument("Aho-Corasick panel too large");
+                }
+                next = static_cast<StateIndex>(created);
+                table_.resize(table_.size() + COLUMNS, NONE);
+            }
+            state = table_[static_cast<size_t>(state) * COLUMNS + column];
+        }
+        patternState.push_back(state);
+        patternLengths_.push_back(pattern.size());
+    }
+    const size_t stateCount = table_.size() / COLUMNS;
+
+    // Renumber breadth-first: text mostly visits the shallow levels, which
+    // then share a compact block of the table instead of being scattered
+    // along the insertion order of the patterns
+    {
+        std::vector<StateIndex> order;
+        order.reserve(stateCount);
+        order.push_back(ROOT);
+        for (size_t head = 0; head < order.size(); ++head) {
+            for (size_t c = 0; c < 4; ++c) {
+                StateIndex next = table_[static_cast<size_t>(order[head]) * COLUMNS + c];
+                if (next != NONE) order.push_back(next);
+            }
+        }
+        std::vector<StateIndex> renumbered(stateCount);
+        for (size_t i = 0; i < stateCount; ++i) renumbered[order[i]] = static_cast<StateIndex>(i);
+        std::vector<StateIndex> table(table_.size(), NONE);
+        for (size_t i = 0; i < stateCount; ++i) {
+            for (size_t c = 0; c < 4; ++c) {
+                StateIndex next = table_[static_cast<size_t>(order[i]) * COLUMNS + c];
+                if (next != NONE) table[i * COLUMNS + c] = renumbered[next];
+            }
+        }
+        table_ = std::move(table);
+        for (StateIndex& s : patternState) s = renumbered[s];
+    }
+
+    // Own outputs in CSR form, in pattern order within each state
+    outputStart_.assign(stateCount + 1, 0);
+    for (StateIndex s : patternState) ++outputStart_[s + 1];
+    for (size_t s = 0; s < stateCount; ++s) outputStart_[s + 1] += outputStart_[s];
+    outputs_.resize(patternState.size());
+    {
+        std::vector<uint32_t> fill(outputStart_.begin(), outputStart_.end() - 1);
+        for (size_t p = 0; p < patternState.size(); ++p) {
+            outputs_[fill[patternState[p]]++] = static_cast<uint32_t>(p);
+        }
+    }
+    auto hasOwnOutput = [&](StateIndex s) { return outputStart_[s] != outputStart_[s + 1]; };
+
+    // Breadth-first order guarantees a state's failure target is complete
+    // before the state itself, so missing edges can copy its row
+    std::vector<StateIndex> failure(stateCount, ROOT);
+    dictionaryLink_.assign(stateCount, NONE);
+    std::vector<StateIndex> queue;
+    queue.reserve(stateCount);
+    for (size_t c = 0; c < 4; ++c) {
+        StateIndex& next = table_[c];
+        if (next == NONE) {
+            next = ROOT;
+        } else {
+            queue.push_back(next);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const StateIndex state = queue[head];
+        const size_t row = static_cast<size_t>(state) * COLUMNS;
+        const size_t failRow = static_cast<size_t>(failure[state]) * COLUMNS;
+        for (size_t c = 0; c < 4; ++c) {
+            StateIndex next = table_[row + c];
+            if (next == NONE) {
+                table_[row + c] = table_[failRow + c];
+                continue;
+            }
+            StateIndex target = table_[failRow + c];
+            failure[next] = target;
+            dictionaryLink_[next] = hasOwnOutput(target) ? target : dictionaryLink_[target];
+            queue.push_back(next);
+        }
+    }
+
+    // Every other byte restarts the search; then flag edges into reporting states
+    for (size_t s = 0; s < stateCount; ++s) table_[s * COLUMNS + 4] = ROOT;
+    for (StateIndex& entry : table_) {
+        if (hasOwnOutput(entry) || dictionaryLink_[entry] != NONE) entry |= OUTPUT_FLAG;
+    }
+}
+
+std::vector<AhoCorasick::Match> AhoCorasick::findAll(const std::string& text) const {
+    std::vector<Match> matches;
+    scan(text.data(), text.size(), [&](uint32_t pattern, size_t end) {
+        matches.push_back({end - patternLengths_[pattern], end, pattern});
+    });
+    return matches;
+}
+
+std::vector<size_t> AhoCorasick::countAll(const std::string& text) const {
+    std::vector<size_t> counts(patternLengths_.size(), 0);
+    scan(text.data(), text.size(), [&](uint32_t pattern, size_t) { ++counts[pattern]; });
+    return counts;
+}
+
+} // namespace bio
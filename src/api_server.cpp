@@ -11,6 +11,7 @@
 #include "bio/approximate_matcher.hpp"
 #include "automata/regex_parser.hpp"
 #include "automata/dfa.hpp"
+#include "automata/lazy_dfa.hpp"
 #include "automata/pda.hpp"
 
 #include <iostream>
@@ -152,24 +153,106 @@ double gcContent(const std::string& sequence) {
     return static_cast<double>(gc) / sequence.size() * 100.0;
 }
 
-int hammingDistance(const std::string& s1, const std::string& s2) {
-    if (s1.length() != s2.length()) return 999999;
-    int dist = 0;
-    for (size_t i = 0; i < s1.length(); i++) {
-        if (s1[i] != s2[i]) dist++;
-    }
-    return dist;
-}
+// Longest sequence searched by the regex engines without DFASearcher's
+// bounded rescans (CountingMatcher, LazyDFA), whose worst case is quadratic
+constexpr size_t MAX_RESCAN_SEQUENCE_LENGTH = 1000000;
 
 // Check if pattern contains regex metacharacters
 bool isRegexPattern(const std::string& pattern) {
-    return pattern.find_first_of("[]|*+?().") != std::string::npos;
+    return pattern.find_first_of("[]|*+?().{}^$") != std::string::npos;
+}
+
+// ============ Pattern Compilation ============
+
+// Only what the compiled form depends on: regexes ignore maxDistance, and
+// both strands are searched with the same compiled pattern
+PatternKey makePatternKey(const std::string& pattern, int maxDistance) {
+    PatternKey key;
+    key.pattern = pattern;
+    std::transform(key.pattern.begin(), key.pattern.end(), key.pattern.begin(), ::toupper);
+    if (isRegexPattern(pattern)) key.flags |= PatternKey::REGEX;
+    else key.maxDistance = maxDistance;
+    return key;
+}
+
+bool hasAnchor(const automata::RegexParser::ASTNode& node) {
+    using NodeType = automata::RegexParser::NodeType;
+    if (node.type == NodeType::START_ANCHOR || node.type == NodeType::END_ANCHOR) return true;
+    for (const auto& child : node.children) {
+        if (child && hasAnchor(*child)) return true;
+    }
+    return false;
+}
+
+// Regexes become a minimized DFA with a leftmost-longest searcher. A counted
+// repetition too large to unroll goes to CountingMatcher instead, and a
+// pattern whose DFAs exceed DFASearcher::Options::maxStates keeps its NFA
+// for a per-request LazyDFA, whose caches are bounded. Throws
+// automata::ParseException for invalid patterns and for anchors, which the
+// engines would otherwise treat as empty strings.
+std::shared_ptr<const CompiledPattern> compilePattern(const PatternKey& key) {
+    auto compiled = std::make_shared<CompiledPattern>();
+    compiled->pattern = key.pattern;
+    if (key.flags & PatternKey::REGEX) {
+        automata::RegexParser parser;
+        if (hasAnchor(*parser.parseAST(compiled->pattern))) {
+            throw automata::ParseException("anchors (^, $) are not supported; matches are found anywhere in the sequence");
+        }
+        automata::CountingMatcher counting(compiled->pattern);
+        if (counting.getCounterCount() > 0) {
+            compiled->counting.emplace(std::move(counting));
+            compiled->engine = "CountingMatcher";
+            return compiled;
+        }
+        try {
+            compiled->searcher = automata::DFASearcher::fromPattern(compiled->pattern);
+            // The compiled form adds an explicit dead state
+            compiled->dfaStates = compiled->searcher->getForward().getStateCount() - 1;
+            compiled->engine = "DFA";
+        } catch (const automata::ParseException&) {
+            throw;
+        } catch (const automata::AutomataException&) {
+            compiled->nfa = parser.parse(compiled->pattern);
+            compiled->engine = "LazyDFA";
+        }
+    } else {
+        compiled->hamming.emplace(compiled->pattern, key.maxDistance);
+        compiled->engine = "HammingMatcher";
+    }
+    return compiled;
 }
 
 // ============ Server Implementation ============
 
-Server::Server(int port, const std::string& staticDir)
-    : port_(port), staticDir_(staticDir), running_(false) {}
+Server::Server(int port, const std::string& staticDir, size_t cacheCapacity)
+    : port_(port), staticDir_(staticDir), running_(false), cache_(cacheCapacity, compilePattern) {}
+
+size_t Server::warmUpCache(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open warm-up file: " + path);
+    }
+    
+    size_t loaded = 0;
+    size_t lineNumber = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream fields(line);
+        std::string pattern;
+        int maxDistance = 0;
+        if (!(fields >> pattern) || pattern[0] == '#') continue;
+        if (!(fields >> maxDistance)) maxDistance = 0;
+        
+        try {
+            cache_.warmUp(makePatternKey(pattern, maxDistance));
+            ++loaded;
+        } catch (const std::exception& e) {
+            std::cerr << path << ":" << lineNumber << ": skipping '" << pattern << "': " << e.what() << std::endl;
+        }
+    }
+    return loaded;
+}
 
 void Server::stop() {
     running_ = false;
@@ -202,6 +285,19 @@ void Server::start() {
         );
     });
     
+    // Compiled-pattern cache statistics
+    svr.Get("/api/cache/stats", [this](const httplib::Request&, httplib::Response& res) {
+        std::ostringstream json;
+        json << "{";
+        json << "\"success\":true,";
+        json << "\"hits\":" << cache_.getHits() << ",";
+        json << "\"misses\":" << cache_.getMisses() << ",";
+        json << "\"size\":" << cache_.size() << ",";
+        json << "\"capacity\":" << cache_.getCapacity();
+        json << "}";
+        res.set_content(json.str(), "application/json");
+    });
+    
     // Analyze DNA sequence
     svr.Post("/api/bio/analyze", [](const httplib::Request& req, httplib::Response& res) {
         res.set_header("Content-Type", "application/json");
@@ -239,7 +335,7 @@ void Server::start() {
     });
     
     // Pattern matching
-    svr.Post("/api/bio/match", [](const httplib::Request& req, httplib::Response& res) {
+    svr.Post("/api/bio/match", [this](const httplib::Request& req, httplib::Response& res) {
         res.set_header("Content-Type", "application/json");
         
         try {
@@ -260,45 +356,48 @@ void Server::start() {
             }
             
             std::string sequence = validateDNA(sequenceStr);
-            std::string patternUpper = pattern;
-            std::transform(patternUpper.begin(), patternUpper.end(), patternUpper.begin(), ::toupper);
+            
+            // Repeat requests reuse the compiled pattern
+            std::shared_ptr<const CompiledPattern> compiled;
+            try {
+                compiled = cache_.get(makePatternKey(pattern, maxDistance));
+            } catch (const automata::ParseException& e) {
+                res.status = 400;
+                res.set_content(jsonError(std::string("Invalid regex: ") + e.what()), "application/json");
+                return;
+            }
+            if ((compiled->counting || compiled->nfa) && sequence.size() > MAX_RESCAN_SEQUENCE_LENGTH) {
+                res.status = 400;
+                res.set_content(jsonError("Sequences longer than " + std::to_string(MAX_RESCAN_SEQUENCE_LENGTH) +
+                                          " bases cannot be searched with " + compiled->engine),
+                                "application/json");
+                return;
+            }
+            const std::string& patternUpper = compiled->pattern;
             
             std::vector<std::tuple<size_t, size_t, std::string, int, std::string>> matches;
             
-            bool useRegex = isRegexPattern(pattern);
+            bool useRegex = !compiled->hamming;
+            // LazyDFA caches are mutated by scanning, so never shared between requests
+            std::optional<automata::LazyDFA> lazy;
+            if (compiled->nfa) lazy.emplace(*compiled->nfa);
+            // Leftmost-longest non-overlapping matches from whichever regex engine was compiled
+            auto findRegex = [&compiled, &lazy](const std::string& text) {
+                if (compiled->counting) return compiled->counting->findAll(text);
+                if (lazy) return lazy->findAll(text);
+                return compiled->searcher->findAll(text);
+            };
             
             if (useRegex) {
-                // Use regex matching
-                try {
-                    std::regex regex(patternUpper);
-                    std::sregex_iterator it(sequence.begin(), sequence.end(), regex);
-                    std::sregex_iterator end;
-                    
-                    while (it != end) {
-                        std::smatch match = *it;
-                        matches.emplace_back(
-                            match.position(),
-                            match.position() + match.length(),
-                            match.str(),
-                            0,
-                            "forward"
-                        );
-                        ++it;
-                    }
-                } catch (const std::regex_error& e) {
-                    res.status = 400;
-                    res.set_content(jsonError(std::string("Invalid regex: ") + e.what()), "application/json");
-                    return;
+                for (const auto& [start, end] : findRegex(sequence)) {
+                    matches.emplace_back(start, end, sequence.substr(start, end - start), 0, "forward");
                 }
             } else {
-                // Exact/approximate matching
+                // Exact/approximate matching: windows within maxDistance mismatches
                 size_t patLen = patternUpper.length();
-                for (size_t i = 0; i + patLen <= sequence.length(); i++) {
-                    std::string substr = sequence.substr(i, patLen);
-                    int dist = hammingDistance(patternUpper, substr);
-                    if (dist <= maxDistance) {
-                        matches.emplace_back(i, i + patLen, substr, dist, "forward");
-                    }
+                for (const auto& hit : compiled->hamming->findAll(sequence)) {
+                    matches.emplace_back(hit.start, hit.start + patLen, sequence.substr(hit.start, patLen),
+                                         hit.mismatches, "forward");
                 }
             }
             
@@ -307,34 +406,19 @@ void Server::start() {
                 std::string revComp = getReverseComplement(sequence);
                 
                 if (useRegex) {
-                    try {
-                        std::regex regex(patternUpper);
-                        std::sregex_iterator it(revComp.begin(), revComp.end(), regex);
-                        std::sregex_iterator end;
-                        
-                        while (it != end) {
-                            std::smatch match = *it;
-                            size_t revStart = match.position();
-                            size_t revEnd = revStart + match.length();
-                            // Convert to forward strand coordinates
-                            size_t fwdStart = sequence.length() - revEnd;
-                            size_t fwdEnd = sequence.length() - revStart;
-                            matches.emplace_back(fwdStart, fwdEnd, match.str(), 0, "reverse");
-                            ++it;
-                        }
-                    } catch (...) {
-                        // Ignore regex errors on reverse strand
+                    // Same engine and semantics as the forward strand
+                    for (const auto& [revStart, revEnd] : findRegex(revComp)) {
+                        // Convert to forward strand coordinates
+                        size_t fwdStart = sequence.length() - revEnd;
+                        size_t fwdEnd = sequence.length() - revStart;
+                        matches.emplace_back(fwdStart, fwdEnd, revComp.substr(revStart, revEnd - revStart), 0, "reverse");
                     }
                 } else {
                     size_t patLen = patternUpper.length();
-                    for (size_t i = 0; i + patLen <= revComp.length(); i++) {
-                        std::string substr = revComp.substr(i, patLen);
-                        int dist = hammingDistance(patternUpper, substr);
-                        if (dist <= maxDistance) {
-                            size_t fwdStart = sequence.length() - (i + patLen);
-                            size_t fwdEnd = fwdStart + patLen;
-                            matches.emplace_back(fwdStart, fwdEnd, substr, dist, "reverse");
-                        }
+                    for (const auto& hit : compiled->hamming->findAll(revComp)) {
+                        size_t fwdStart = sequence.length() - (hit.start + patLen);
+                        size_t fwdEnd = fwdStart + patLen;
+                        matches.emplace_back(fwdStart, fwdEnd, revComp.substr(hit.start, patLen), hit.mismatches, "reverse");
                     }
                 }
             }
@@ -362,8 +446,8 @@ void Server::start() {
             
             json << "],";
             json << "\"count\":" << matches.size() << ",";
-            json << "\"dfaStates\":" << (patternUpper.length() + 1) << ",";
-            json << "\"matchType\":\"" << (maxDistance > 0 ? "Levenshtein DFA" : "DFA") << "\"";
+            if (compiled->dfaStates) json << "\"dfaStates\":" << *compiled->dfaStates << ",";
+            json << "\"matchType\":\"" << compiled->engine << "\"";
             json << "}";
             
             res.set_content(json.str(), "application/json");
@@ -611,26 +695,63 @@ void Server::start() {
 
 // ============ Main Entry Point ============
 
+namespace {
+
+// Non-negative decimal option value; false if text is not one
+bool parseCount(const std::string& text, unsigned long long& value) {
+    if (text.empty() || !std::all_of(text.begin(), text.end(), ::isdigit)) return false;
+    try {
+        value = std::stoull(text);
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
     int port = 5000;
     std::string staticDir = "./vite/dist";
+    size_t cacheCapacity = api::PatternCache::DEFAULT_CAPACITY;
+    std::string warmUpFile;
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         if (arg == "-p" || arg == "--port") {
             if (i + 1 < argc) {
-                port = std::stoi(argv[++i]);
+                unsigned long long value = 0;
+                if (!parseCount(argv[++i], value) || value > 65535) {
+                    std::cerr << "Invalid port: " << argv[i] << std::endl;
+                    return 1;
+                }
+                port = static_cast<int>(value);
             }
         } else if (arg == "-s" || arg == "--static") {
             if (i + 1 < argc) {
                 staticDir = argv[++i];
             }
+        } else if (arg == "-c" || arg == "--cache-size") {
+            if (i + 1 < argc) {
+                unsigned long long value = 0;
+                if (!parseCount(argv[++i], value)) {
+                    std::cerr << "Invalid cache size: " << argv[i] << std::endl;
+                    return 1;
+                }
+                cacheCapacity = static_cast<size_t>(value);
+            }
+        } else if (arg == "-w" || arg == "--warm-up") {
+            if (i + 1 < argc) {
+                warmUpFile = argv[++i];
+            }
         } else if (arg == "-h" || arg == "--help") {
             std::cout << "DNA Pattern Matcher - C++ API Server\n\n";
             std::cout << "Usage: api_server [options]\n\n";
             std::cout << "Options:\n";
             std::cout << "  -p, --port <port>      Port to listen on (default: 5000)\n";
             std::cout << "  -s, --static <dir>     Static files directory (default: ./vite/dist)\n";
+            std::cout << "  -c, --cache-size <n>   Compiled patterns to cache (default: 256, 0 disables)\n";
+            std::cout << "  -w, --warm-up <file>   Precompile the patterns listed in file\n";
             std::cout << "  -h, --help             Show this help message\n";
             return 0;
         } else {
@@ -644,7 +765,16 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    api::Server server(port, staticDir);
+    api::Server server(port, staticDir, cacheCapacity);
+    if (!warmUpFile.empty()) {
+        try {
+            size_t loaded = server.warmUpCache(warmUpFile);
+            std::cout << "Warmed up pattern cache with " << loaded << " patterns" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
     server.start();
     
     return 0;
@@ -1,14 +1,47 @@
 #include "bio/approximate_matcher.hpp"
+#include "bio/myers_matcher.hpp"
+#include "bio/levenshtein_automaton.hpp"
+#include "bio/edit_distance.hpp"
+#include "bio/hamming_matcher.hpp"
+#include "bio/aho_corasick.hpp"
+#include "bio/kmer_index.hpp"
+#include "automata/frozen_nfa.hpp"
 #include <algorithm>
+#include <cctype>
 #include <limits>
+#include <map>
 
 namespace bio {
 
+namespace {
+
+// Shorter pigeonhole pieces hit too often for seeding to beat a full scan
+constexpr size_t MIN_AUTO_SEED_LENGTH = 8;
+
+} // namespace
+
 ApproximateMatcher::ApproximateMatcher(const std::string& pattern, int maxDistance, int editTypes)
-    : pattern_(pattern), maxDistance_(maxDistance), editTypes_(editTypes) {
+    : pattern_(pattern), maxDistance_(maxDistance), editTypes_(editTypes), strategy_(Strategy::AUTO) {
     buildAlphabet();
 }
 
+void ApproximateMatcher::setStrategy(Strategy strategy) {
+    if ((strategy == Strategy::BIT_VECTOR || strategy == Strategy::SEED_AND_VERIFY) &&
+        editTypes_ != static_cast<int>(EditType::ALL)) {
+        throw std::invalid_argument("Bit-vector search requires all edit types");
+    }
+    if (strategy == Strategy::UNIVERSAL_AUTOMATON && !hasUniversalAutomaton()) {
+        throw std::invalid_argument("Universal automaton search requires all edit types and maxDistance 0-" +
+                                    std::to_string(UniversalLevenshtein::MAX_DISTANCE));
+    }
+    strategy_ = strategy;
+}
+
+bool ApproximateMatcher::hasUniversalAutomaton() const {
+    return editTypes_ == static_cast<int>(EditType::ALL) && maxDistance_ >= 0 &&
+           maxDistance_ <= UniversalLevenshtein::MAX_DISTANCE;
+}
+
 void ApproximateMatcher::buildAlphabet() {
     for (char c : pattern_) {
         alphabet_.insert(c);
@@ -16,6 +49,9 @@ void ApproximateMatcher::buildAlphabet() {
     // Add common characters
     for (char c = 'A'; c <= 'Z'; ++c) alphabet_.insert(c);
     for (char c = 'a'; c <= 'z'; ++c) alphabet_.insert(c);
+    
+    std::fill(std::begin(inAlphabet_), std::end(inAlphabet_), false);
+    for (char c : alphabet_) inAlphabet_[static_cast<unsigned char>(c)] = true;
 }
 
 automata::StateId ApproximateMatcher::encodeState(int pos, int edits) const {
@@ -43,6 +79,10 @@ automata::NFA ApproximateMatcher::buildNFA() const {
     
     nfa.setStartState(stateMap[{0, 0}]);
     
+    // Every insertion edge carries the whole alphabet as one class edge
+    automata::SymbolSet anySymbol;
+    for (char c : alphabet_) anySymbol.add(c);
+
     // Add transitions
     for (int pos = 0; pos < n; ++pos) {
         for (int edits = 0; edits <= maxDistance_; ++edits) {
@@ -54,18 +94,16 @@ automata::NFA ApproximateMatcher::buildNFA() const {
             if (edits < maxDistance_) {
                 // Substitution (if allowed)
                 if (editTypes_ & static_cast<int>(EditType::SUBSTITUTION)) {
-                    for (char c : alphabet_) {
-                        if (c != pattern_[pos]) {
-                            nfa.addTransition(from, stateMap[{pos + 1, edits + 1}], c);
-                        }
+                    automata::SymbolSet substitutes = anySymbol;
+                    substitutes.remove(pattern_[pos]);
+                    if (!substitutes.empty()) {
+                        nfa.addTransition(from, stateMap[{pos + 1, edits + 1}], substitutes);
                     }
                 }
                 
                 // Insertion (if allowed) - consume input without advancing pattern
-                if (editTypes_ & static_cast<int>(EditType::INSERTION)) {
-                    for (char c : alphabet_) {
-                        nfa.addTransition(from, stateMap[{pos, edits + 1}], c);
-                    }
+                if (editTypes_ & static_cast<int>(EditType::INSERTION) && !anySymbol.empty()) {
+                    nfa.addTransition(from, stateMap[{pos, edits + 1}], anySymbol);
                 }
                 
                 // Deletion (if allowed) - advance pattern without consuming input
@@ -76,26 +114,94 @@ automata::NFA ApproximateMatcher::buildNFA() const {
         }
     }
     
+    // Insertions after the last pattern character
+    if (editTypes_ & static_cast<int>(EditType::INSERTION) && !anySymbol.empty()) {
+        for (int edits = 0; edits < maxDistance_; ++edits) {
+            nfa.addTransition(stateMap[{n, edits}], stateMap[{n, edits + 1}], anySymbol);
+        }
+    }
+    
     return nfa;
 }
 
 automata::DFA ApproximateMatcher::buildDFA() const {
-    return automata::DFA::fromNFA(buildNFA());
+    if (!hasUniversalAutomaton()) return automata::DFA::fromNFA(buildNFA());
+    
+    // Each reachable (universal state, base) pair becomes one DFA state
+    LevenshteinDFA levenshtein(pattern_, maxDistance_);
+    automata::DFA dfa;
+    std::map<std::pair<UniversalLevenshtein::State, size_t>, automata::StateId> ids;
+    std::vector<LevenshteinDFA::Cursor> work;
+    auto stateFor = [&](LevenshteinDFA::Cursor cursor) {
+        auto it = ids.find({cursor.state, cursor.base});
+        if (it != ids.end()) return it->second;
+        automata::StateId id = dfa.addState("", levenshtein.isAccepting(cursor));
+        ids[{cursor.state, cursor.base}] = id;
+        work.push_back(cursor);
+        return id;
+    };
+    
+    dfa.setStartState(stateFor(levenshtein.start()));
+    while (!work.empty()) {
+        LevenshteinDFA::Cursor cursor = work.back();
+        work.pop_back();
+        automata::StateId from = ids[{cursor.state, cursor.base}];
+        for (char c : alphabet_) {
+            LevenshteinDFA::Cursor next = levenshtein.next(cursor, c);
+            if (!LevenshteinDFA::isDead(next)) dfa.addTransition(from, stateFor(next), c);
+        }
+    }
+    return dfa;
 }
 
 bool ApproximateMatcher::matches(const std::string& text) const {
-    return buildNFA().accepts(text);
+    if (!hasUniversalAutomaton()) return buildNFA().accepts(text);
+    
+    LevenshteinDFA levenshtein(pattern_, maxDistance_);
+    LevenshteinDFA::Cursor cursor = levenshtein.start();
+    for (char c : text) {
+        if (!inAlphabet_[static_cast<unsigned char>(c)]) return false;
+        cursor = levenshtein.next(cursor, c);
+        if (LevenshteinDFA::isDead(cursor)) return false;
+    }
+    return levenshtein.isAccepting(cursor);
 }
 
 std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAll(const std::string& text) const {
+    Strategy strategy = strategy_;
+    if (strategy == Strategy::AUTO) {
+        strategy = editTypes_ == static_cast<int>(EditType::ALL) ? Strategy::BIT_VECTOR : Strategy::NFA_SIMULATION;
+        if (canSeed() && pattern_.size() / (maxDistance_ + 1) >= MIN_AUTO_SEED_LENGTH) {
+            strategy = Strategy::SEED_AND_VERIFY;
+        }
+    }
+    // The bit-vector DP has no rows for an empty pattern
+    if (strategy == Strategy::BIT_VECTOR && !pattern_.empty() && maxDistance_ >= 0) {
+        return findAllBitVector(text);
+    }
+    if (strategy == Strategy::UNIVERSAL_AUTOMATON) {
+        return findAllUniversal(text);
+    }
+    if (strategy == Strategy::SEED_AND_VERIFY && !pattern_.empty() && maxDistance_ >= 0) {
+        return findAllSeeded(text);
+    }
+    return findAllNFA(text);
+}
+
+std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAllNFA(const std::string& text) const {
     std::vector<Match> matches;
-    auto nfa = buildNFA();
+    automata::FrozenNFA nfa = buildNFA().freeze();
+    automata::NFASimulator simulator(nfa);
     
+    // Each start extends one simulation symbol by symbol instead of
+    // re-running the NFA on every substring
     for (size_t start = 0; start < text.size(); ++start) {
+        simulator.reset();
         for (size_t len = 1; len <= text.size() - start && len <= pattern_.size() + maxDistance_; ++len) {
-            std::string substr = text.substr(start, len);
-            if (nfa.accepts(substr)) {
-                int dist = editDistance(pattern_, substr);
+            if (!simulator.step(text[start + len - 1])) break;
+            if (simulator.isAccepting()) {
+                std::string substr = text.substr(start, len);
+                int dist = editDistance(pattern_, substr, maxDistance_);
                 if (dist <= maxDistance_) {
                     matches.push_back({start, start + len, dist, substr});
                 }
@@ -106,64 +212,189 @@ std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAll(const std::st
     return matches;
 }
 
-int ApproximateMatcher::editDistance(const std::string& s1, const std::string& s2) {
-    int m = s1.size(), n = s2.size();
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1));
-    
-    for (int i = 0; i <= m; ++i) dp[i][0] = i;
-    for (int j = 0; j <= n; ++j) dp[0][j] = j;
+std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAllBitVector(const std::string& text) const {
+    std::vector<Match> matches;
+    verifyWindow(MyersMatcher(pattern_), text, 0, text.size(), matches);
+    sortMatches(matches);
+    return matches;
+}
+
+void ApproximateMatcher::verifyWindow(const MyersMatcher& myers, const std::string& text,
+                                      size_t begin, size_t end, std::vector<Match>& matches) const {
+    const size_t m = pattern_.size();
+    const size_t k = static_cast<size_t>(maxDistance_);
+    const size_t minLength = m > k ? m - k : 1;
     
-    for (int i = 1; i <= m; ++i) {
-        for (int j = 1; j <= n; ++j) {
-            if (s1[i-1] == s2[j-1]) {
-                dp[i][j] = dp[i-1][j-1];
-            } else {
-                dp[i][j] = 1 + std::min({dp[i-1][j], dp[i][j-1], dp[i-1][j-1]});
+    // The NFA cannot consume characters outside alphabet_, even as an edit,
+    // so matches never span them; each run between them is searched alone
+    std::vector<int> distances;
+    size_t segment = begin;
+    while (segment < end) {
+        size_t segmentEnd = segment;
+        while (segmentEnd < end && inAlphabet_[static_cast<unsigned char>(text[segmentEnd])]) ++segmentEnd;
+        
+        // Each end within k of the pattern is scanned back for every start
+        const char* data = text.data() + segment;
+        for (const auto& hit : myers.findEnds(data, segmentEnd - segment, maxDistance_)) {
+            myers.distancesEndingAt(data, hit.end, m + k, distances);
+            for (size_t len = minLength; len < distances.size(); ++len) {
+                if (distances[len] <= maxDistance_) {
+                    size_t start = segment + hit.end - len;
+                    matches.push_back({start, segment + hit.end, distances[len], text.substr(start, len)});
+                }
             }
         }
+        segment = segmentEnd + 1;
     }
+}
+
+void ApproximateMatcher::sortMatches(std::vector<Match>& matches) {
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        return a.start != b.start ? a.start < b.start : a.end < b.end;
+    });
+}
+
+std::vector<std::pair<size_t, std::string>> ApproximateMatcher::pigeonholeSeeds() const {
+    // k edits leave at least one of k + 1 disjoint pieces intact
+    std::vector<std::pair<size_t, std::string>> seeds;
+    const size_t pieces = static_cast<size_t>(maxDistance_) + 1;
+    size_t offset = 0;
+    for (size_t i = 0; i < pieces; ++i) {
+        size_t length = pattern_.size() / pieces + (i < pattern_.size() % pieces ? 1 : 0);
+        seeds.push_back({offset, pattern_.substr(offset, length)});
+        offset += length;
+    }
+    return seeds;
+}
+
+bool ApproximateMatcher::canSeed() const {
+    if (editTypes_ != static_cast<int>(EditType::ALL) || maxDistance_ < 0) return false;
+    if (pattern_.size() < static_cast<size_t>(maxDistance_) + 1) return false;
+    return pattern_.find_first_not_of("ACGTacgt") == std::string::npos;
+}
+
+std::vector<ApproximateMatcher::Match> ApproximateMatcher::verifySeedHits(
+    const std::string& text, std::vector<std::pair<size_t, size_t>>& windows) const {
+    // A match containing a seed found at t with pattern offset p lies in
+    // [t - p - k, t - p + m + k); overlapping windows are verified once
+    std::sort(windows.begin(), windows.end());
+    std::vector<Match> matches;
+    MyersMatcher myers(pattern_);
+    size_t i = 0;
+    while (i < windows.size()) {
+        size_t begin = windows[i].first;
+        size_t end = windows[i].second;
+        for (++i; i < windows.size() && windows[i].first <= end; ++i) end = std::max(end, windows[i].second);
+        verifyWindow(myers, text, begin, end, matches);
+    }
+    sortMatches(matches);
+    return matches;
+}
+
+std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAllSeeded(const std::string& text) const {
+    if (!canSeed()) return findAllBitVector(text);
     
-    return dp[m][n];
+    auto seeds = pigeonholeSeeds();
+    std::vector<std::string> literals;
+    for (const auto& seed : seeds) literals.push_back(seed.second);
+    AhoCorasick automaton(literals);
+    
+    const size_t m = pattern_.size();
+    const size_t k = static_cast<size_t>(maxDistance_);
+    std::vector<std::pair<size_t, size_t>> windows;
+    automaton.scan(text.data(), text.size(), [&](size_t seed, size_t seedEnd) {
+        const size_t anchor = seedEnd - seeds[seed].second.size();  // Where pattern offset p landed
+        const size_t origin = anchor >= seeds[seed].first ? anchor - seeds[seed].first : 0;
+        windows.push_back({origin > k ? origin - k : 0, std::min(text.size(), origin + m + k)});
+    });
+    return verifySeedHits(text, windows);
 }
 
-std::vector<ApproximateMatcher::EditOperation> 
-ApproximateMatcher::getEditOperations(const std::string& s1, const std::string& s2) {
-    int m = s1.size(), n = s2.size();
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1));
+std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAll(const std::string& text, const KmerIndex& index) const {
+    if (index.getReferenceLength() != text.size()) {
+        throw std::invalid_argument("k-mer index was built for a different text");
+    }
+    auto seeds = pigeonholeSeeds();
+    const size_t q = static_cast<size_t>(index.getK());
+    if (!canSeed() || seeds.back().second.size() < q) return findAll(text);
     
-    for (int i = 0; i <= m; ++i) dp[i][0] = i;
-    for (int j = 0; j <= n; ++j) dp[0][j] = j;
+    const size_t m = pattern_.size();
+    const size_t k = static_cast<size_t>(maxDistance_);
+    std::vector<std::pair<size_t, size_t>> windows;
+    for (const auto& [offset, seed] : seeds) {
+        auto [first, last] = index.lookup(seed.data());
+        for (const uint32_t* p = first; p != last; ++p) {
+            const size_t anchor = *p;
+            // The index matched the first q bases; the rest must agree too
+            if (anchor + seed.size() > text.size()) continue;
+            bool agrees = true;
+            for (size_t j = q; j < seed.size() && agrees; ++j) {
+                agrees = std::toupper(static_cast<unsigned char>(text[anchor + j])) ==
+                         std::toupper(static_cast<unsigned char>(seed[j]));
+            }
+            if (!agrees) continue;
+            const size_t origin = anchor >= offset ? anchor - offset : 0;
+            windows.push_back({origin > k ? origin - k : 0, std::min(text.size(), origin + m + k)});
+        }
+    }
+    return verifySeedHits(text, windows);
+}
+
+std::vector<ApproximateMatcher::Match> ApproximateMatcher::findAllUniversal(const std::string& text) const {
+    std::vector<Match> matches;
+    LevenshteinDFA levenshtein(pattern_, maxDistance_);
+    const size_t maxLength = pattern_.size() + maxDistance_;
     
-    for (int i = 1; i <= m; ++i) {
-        for (int j = 1; j <= n; ++j) {
-            if (s1[i-1] == s2[j-1]) {
-                dp[i][j] = dp[i-1][j-1];
-            } else {
-                dp[i][j] = 1 + std::min({dp[i-1][j], dp[i][j-1], dp[i-1][j-1]});
+    // The walk's state already holds the distance, so no DP runs per match
+    for (size_t start = 0; start < text.size(); ++start) {
+        LevenshteinDFA::Cursor cursor = levenshtein.start();
+        for (size_t len = 1; len <= text.size() - start && len <= maxLength; ++len) {
+            const char c = text[start + len - 1];
+            if (!inAlphabet_[static_cast<unsigned char>(c)]) break;
+            cursor = levenshtein.next(cursor, c);
+            if (LevenshteinDFA::isDead(cursor)) break;
+            const int dist = levenshtein.distance(cursor);
+            if (dist <= maxDistance_) {
+                matches.push_back({start, start + len, dist, text.substr(start, len)});
             }
         }
     }
     
-    // Backtrack
+    return matches;
+}
+
+int ApproximateMatcher::editDistance(const std::string& s1, const std::string& s2) {
+    return EditDistance::distance(s1, s2);
+}
+
+int ApproximateMatcher::editDistance(const std::string& s1, const std::string& s2, int maxDistance) {
+    return EditDistance::bounded(s1, s2, maxDistance);
+}
+
+std::vector<ApproximateMatcher::EditOperation> 
+ApproximateMatcher::getEditOperations(const std::string& s1, const std::string& s2) {
     std::vector<EditOperation> ops;
-    int i = m, j = n;
-    while (i > 0 || j > 0) {
-        if (i > 0 && j > 0 && s1[i-1] == s2[j-1]) {
-            ops.push_back({EditOperation::MATCH, static_cast<size_t>(i-1), s1[i-1]});
-            --i; --j;
-        } else if (i > 0 && j > 0 && dp[i][j] == dp[i-1][j-1] + 1) {
-            ops.push_back({EditOperation::SUBSTITUTE, static_cast<size_t>(i-1), s2[j-1]});
-            --i; --j;
-        } else if (j > 0 && dp[i][j] == dp[i][j-1] + 1) {
-            ops.push_back({EditOperation::INSERT, static_cast<size_t>(i), s2[j-1]});
-            --j;
-        } else {
-            ops.push_back({EditOperation::DELETE, static_cast<size_t>(i-1), s1[i-1]});
-            --i;
+    size_t i = 0, j = 0;
+    for (EditDistance::Op op : EditDistance::alignment(s1, s2)) {
+        switch (op) {
+            case EditDistance::Op::MATCH:
+                ops.push_back({EditOperation::MATCH, i, s1[i]});
+                ++i; ++j;
+                break;
+            case EditDistance::Op::SUBSTITUTE:
+                ops.push_back({EditOperation::SUBSTITUTE, i, s2[j]});
+                ++i; ++j;
+                break;
+            case EditDistance::Op::INSERT:
+                ops.push_back({EditOperation::INSERT, i, s2[j]});
+                ++j;
+                break;
+            case EditDistance::Op::DELETE:
+                ops.push_back({EditOperation::DELETE, i, s1[i]});
+                ++i;
+                break;
         }
     }
-    
-    std::reverse(ops.begin(), ops.end());
     return ops;
 }
 
@@ -186,7 +417,25 @@ DNAApproximateMatcher::DNAApproximateMatcher(const std::string& pattern, int max
 
 std::vector<ApproximateMatcher::Match> 
 DNAApproximateMatcher::findInSequence(const Sequence& seq) const {
-    return findAll(seq.getString());
+    const std::string& text = seq.getString();
+    if (getPattern().empty()) return findAll(text);
+    
+    std::vector<Match> matches;
+    HammingMatcher hamming(getPattern(), getMaxDistance());
+    const size_t m = getPattern().size();
+    size_t segment = 0;
+    while (segment < text.size()) {
+        size_t segmentEnd = segment;
+        while (segmentEnd < text.size() && isInAlphabet(text[segmentEnd])) ++segmentEnd;
+        for (const auto& hit : hamming.findAll(text.data() + segment, segmentEnd - segment)) {
+            // Edit distance can be below the mismatch count (e.g. a shift)
+            std::string substr = text.substr(segment + hit.start, m);
+            int dist = editDistance(getPattern(), substr, hit.mismatches);
+            matches.push_back({segment + hit.start, segment + hit.start + m, dist, substr});
+        }
+        segment = segmentEnd + 1;
+    }
+    return matches;
 }
 
 std::vector<DNAApproximateMatcher::StrandMatch> 
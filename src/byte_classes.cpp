@@ -0,0 +1,83 @@
+#include "automata/byte_classes.hpp"
+#include "automata/nfa.hpp"
+#include "automata/dfa.hpp"
+
+namespace automata {
+
+ByteClasses::ByteClasses() {
+    classes_.fill(0);
+    members_.assign(1, {});
+    for (int b = 0; b < 256; ++b) members_[0].push_back(static_cast<Symbol>(b));
+}
+
+ByteClasses ByteClasses::fromTransitions(const std::vector<Transition>& transitions) {
+    using SymbolBits = std::array<uint64_t, 4>;
+    auto hasBit = [](const SymbolBits& bits, int b) {
+        return (bits[b >> 6] >> (b & 63)) & 1;
+    };
+
+    // Symbols labelling the same (from, to) pair must be told apart only
+    // if some other pair separates them, so refine by each distinct label set
+    std::map<std::pair<StateId, StateId>, SymbolBits> edgeLabels;
+    SymbolBits alphabet{};
+    for (const auto& t : transitions) {
+        if (t.isEpsilon()) continue;
+        // Class edges contribute their whole label set at once
+        const SymbolBits bits = t.getSymbols().getBits();
+        SymbolBits& labels = edgeLabels[{t.getFrom(), t.getTo()}];
+        for (size_t w = 0; w < bits.size(); ++w) {
+            labels[w] |= bits[w];
+            alphabet[w] |= bits[w];
+        }
+    }
+    std::set<SymbolBits> splitters;
+    splitters.insert(alphabet);
+    for (const auto& [edge, bits] : edgeLabels) splitters.insert(bits);
+
+    std::array<int, 256> current{};
+    for (const auto& bits : splitters) {
+        std::map<std::pair<int, bool>, int> refined;
+        for (int b = 0; b < 256; ++b) {
+            auto key = std::make_pair(current[b], static_cast<bool>(hasBit(bits, b)));
+            auto it = refined.emplace(key, static_cast<int>(refined.size())).first;
+            current[b] = it->second;
+        }
+    }
+
+    // Number classes by first member; byte 0 is EPSILON so class 0 is the
+    // class of bytes that label nothing
+    ByteClasses result;
+    result.members_.clear();
+    std::map<int, uint8_t> renumber;
+    for (int b = 0; b < 256; ++b) {
+        auto it = renumber.find(current[b]);
+        if (it == renumber.end()) {
+            it = renumber.emplace(current[b], static_cast<uint8_t>(result.members_.size())).first;
+            result.members_.emplace_back();
+        }
+        result.classes_[b] = it->second;
+        result.members_[it->second].push_back(static_cast<Symbol>(b));
+    }
+    return result;
+}
+
+ByteClasses ByteClasses::fromNFA(const NFA& nfa) {
+    return fromTransitions(nfa.getTransitions());
+}
+
+ByteClasses ByteClasses::fromDFA(const DFA& dfa) {
+    return fromTransitions(dfa.getTransitions());
+}
+
+std::string ByteClasses::toString() const {
+    std::ostringstream oss;
+    oss << "ByteClasses (" << members_.size() << "):\n";
+    for (size_t c = 1; c < members_.size(); ++c) {
+        oss << "  " << c << ": ";
+        for (Symbol s : members_[c]) oss << symbolToString(s);
+        oss << "\n";
+    }
+    return oss.str();
+}
+
+} // namespace automata
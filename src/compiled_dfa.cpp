@@ -0,0 +1,171 @@
+#include "automata/compiled_dfa.hpp"
+
+namespace automata {
+
+CompiledDFA::CompiledDFA()
+    : start_(DEAD), stateCount_(1), columnCount_(1), strideShift_(0) {
+    columns_.fill(0);
+    table_.assign(1, DEAD);
+    accepting_.assign(1, 0);
+}
+
+CompiledDFA CompiledDFA::fromDFA(const DFA& dfa) {
+    CompiledDFA result;
+
+    // One column per alphabet equivalence class; column 0 collects every
+    // byte that never labels a transition
+    ByteClasses classes = dfa.getByteClasses();
+    for (int b = 0; b < 256; ++b) result.columns_[b] = classes.get(static_cast<Symbol>(b));
+    size_t columns = classes.getClassCount();
+    result.columnCount_ = columns;
+    result.strideShift_ = 0;
+    while ((size_t{1} << result.strideShift_) < columns) ++result.strideShift_;
+
+    // Contiguous renumbering; index 0 is the dead state
+    std::map<StateId, Index> index;
+    Index nextIndex = 1;
+    for (const auto& [id, state] : dfa.getStates()) index[id] = nextIndex++;
+    result.stateCount_ = nextIndex;
+
+    result.table_.assign(result.stateCount_ << result.strideShift_, DEAD);
+    for (const auto& t : dfa.getTransitions()) {
+        size_t row = static_cast<size_t>(index.at(t.getFrom())) << result.strideShift_;
+        result.table_[row | result.columns_[static_cast<unsigned char>(t.getSymbol())]] = index.at(t.getTo());
+    }
+
+    result.accepting_.assign((result.stateCount_ + 63) / 64, 0);
+    for (StateId s : dfa.getAcceptingStates()) {
+        Index i = index.at(s);
+        result.accepting_[i >> 6] |= uint64_t{1} << (i & 63);
+    }
+
+    auto start = index.find(dfa.getStartState());
+    result.start_ = start != index.end() ? start->second : DEAD;
+    return result;
+}
+
+size_t CompiledDFA::getMemoryUsage() const {
+    return sizeof(*this) + table_.size() * sizeof(Index) + accepting_.size() * sizeof(uint64_t);
+}
+
+CompiledDFA::Index CompiledDFA::run(Index state, const char* data, size_t length) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    const Index* table = table_.data();
+    const uint8_t* columns = columns_.data();
+    const unsigned shift = strideShift_;
+
+    // The dead state loops to itself, so it is enough to test for it once per block
+    constexpr size_t BLOCK = 32;
+    size_t i = 0;
+    while (length - i >= BLOCK) {
+        for (size_t j = 0; j < BLOCK; ++j) {
+            state = table[(static_cast<size_t>(state) << shift) | columns[bytes[i + j]]];
+        }
+        i += BLOCK;
+        if (state == DEAD) return DEAD;
+    }
+    for (; i < length; ++i) {
+        state = table[(static_cast<size_t>(state) << shift) | columns[bytes[i]]];
+    }
+    return state;
+}
+
+bool CompiledDFA::accepts(const std::string& input) const {
+    return accepts(input.data(), input.size());
+}
+
+bool CompiledDFA::accepts(const char* data, size_t length) const {
+    return isAccepting(run(start_, data, length));
+}
+
+template <typename Successors>
+CompiledDFA CompiledDFA::determinize(const CompiledDFA& layout, const std::vector<Index>& initial,
+                                     const std::vector<Index>& restart,
+                                     const std::vector<bool>& accepting, size_t maxStates,
+                                     Successors successors) {
+    CompiledDFA result;
+    result.columns_ = layout.columns_;
+    result.columnCount_ = layout.columnCount_;
+    result.strideShift_ = layout.strideShift_;
+    const size_t stride = size_t{1} << result.strideShift_;
+
+    std::map<std::vector<Index>, Index> stateMap;
+    std::vector<std::vector<Index>> sets;
+    std::vector<bool> setAccepting;
+    auto intern = [&](std::vector<Index>& set) -> Index {
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+        if (set.empty()) return DEAD;
+        auto it = stateMap.find(set);
+        if (it != stateMap.end()) return it->second;
+        Index id = static_cast<Index>(sets.size() + 1);
+        if (id >= maxStates) {
+            throw AutomataException("Subset construction exceeds " + std::to_string(maxStates) + " DFA states");
+        }
+        bool isAcc = false;
+        for (Index s : set) if (accepting[s]) { isAcc = true; break; }
+        stateMap.emplace(set, id);
+        sets.push_back(set);
+        setAccepting.push_back(isAcc);
+        return id;
+    };
+
+    result.table_.assign(stride, DEAD);
+    std::vector<Index> next = initial;
+    result.start_ = intern(next);
+    for (size_t i = 0; i < sets.size(); ++i) {
+        std::vector<Index> current = sets[i];
+        result.table_.resize((i + 2) * stride, DEAD);
+        for (size_t col = 0; col < result.columnCount_; ++col) {
+            next = restart;
+            for (Index q : current) successors(q, col, next);
+            Index target = intern(next);
+            result.table_[(i + 1) * stride + col] = target;
+        }
+    }
+
+    result.stateCount_ = sets.size() + 1;
+    result.accepting_.assign((result.stateCount_ + 63) / 64, 0);
+    for (size_t i = 0; i < setAccepting.size(); ++i) {
+        if (setAccepting[i]) result.accepting_[(i + 1) >> 6] |= uint64_t{1} << ((i + 1) & 63);
+    }
+    return result;
+}
+
+CompiledDFA CompiledDFA::unanchored(size_t maxStates) const {
+    std::vector<Index> restart;
+    if (start_ != DEAD) restart.push_back(start_);
+    std::vector<bool> accepting(stateCount_);
+    for (Index s = 0; s < stateCount_; ++s) accepting[s] = isAccepting(s);
+    return determinize(*this, restart, restart, accepting, maxStates,
+        [this](Index q, size_t col, std::vector<Index>& out) {
+            Index t = table_[(static_cast<size_t>(q) << strideShift_) | col];
+            if (t != DEAD) out.push_back(t);
+        });
+}
+
+CompiledDFA CompiledDFA::reversed(bool unanchored, size_t maxStates) const {
+    // Predecessor lists per (state, column); edges into the dead state are
+    // irrelevant because the dead state never reaches an accepting state
+    const size_t stride = size_t{1} << strideShift_;
+    std::vector<std::vector<Index>> predecessors(stateCount_ * stride);
+    for (Index q = 1; q < stateCount_; ++q) {
+        for (size_t col = 0; col < columnCount_; ++col) {
+            Index t = table_[q * stride + col];
+            if (t != DEAD) predecessors[t * stride + col].push_back(q);
+        }
+    }
+
+    std::vector<Index> initial;
+    for (Index s = 1; s < stateCount_; ++s) if (isAccepting(s)) initial.push_back(s);
+    std::vector<Index> restart = unanchored ? initial : std::vector<Index>{};
+    std::vector<bool> accepting(stateCount_, false);
+    if (start_ != DEAD) accepting[start_] = true;
+    return determinize(*this, initial, restart, accepting, maxStates,
+        [&predecessors, stride](Index q, size_t col, std::vector<Index>& out) {
+            const auto& preds = predecessors[q * stride + col];
+            out.insert(out.end(), preds.begin(), preds.end());
+        });
+}
+
+} // namespace automata
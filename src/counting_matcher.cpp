@@ -0,0 +1,435 @@
+#include "automata/counting_matcher.hpp"
+#include "automata/regex_optimizer.hpp"
+#include <algorithm>
+
+namespace automata {
+
+/**
+ * @brief Thompson construction over the AST with counters for large {m,n}
+ *
+ * With reversed set, concatenations are mirrored, which yields an automaton
+ * for the reverse language.
+ */
+class CountingMatcher::Compiler {
+public:
+    Compiler(Program& program, size_t unrollLimit, bool reversed)
+        : program_(program), unrollLimit_(unrollLimit), reversed_(reversed) {}
+
+    void compile(const std::shared_ptr<RegexParser::ASTNode>& root) {
+        Fragment top = build(root);
+        program_.start = top.start;
+        program_.accept = top.end;
+
+        // Flatten the per-state lists; counted states get ceil(max / 64) words
+        const size_t n = regions_.size();
+        program_.wordStart.assign(1, 0);
+        program_.symbolStart.assign(1, 0);
+        program_.epsilonStart.assign(1, 0);
+        for (size_t q = 0; q < n; ++q) {
+            uint32_t width = regions_[q] < 0 ? 1 : (program_.counters[regions_[q]].max + 63) / 64;
+            program_.wordStart.push_back(program_.wordStart.back() + width);
+            program_.symbolEdges.insert(program_.symbolEdges.end(), symbolEdges_[q].begin(), symbolEdges_[q].end());
+            program_.epsilonEdges.insert(program_.epsilonEdges.end(), epsilonEdges_[q].begin(), epsilonEdges_[q].end());
+            program_.symbolStart.push_back(static_cast<uint32_t>(program_.symbolEdges.size()));
+            program_.epsilonStart.push_back(static_cast<uint32_t>(program_.epsilonEdges.size()));
+        }
+    }
+
+private:
+    using Node = std::shared_ptr<RegexParser::ASTNode>;
+    using NodeType = RegexParser::NodeType;
+
+    struct Fragment {
+        uint32_t start;
+        uint32_t end;
+    };
+
+    // Size of the automaton a node compiles to, and whether it uses a counter
+    struct Plan {
+        size_t states;
+        bool hasCounter;
+    };
+
+    Program& program_;
+    size_t unrollLimit_;
+    bool reversed_;
+    int32_t region_ = -1;  // Counter owning the states being created, if any
+    std::vector<int32_t> regions_;
+    std::vector<std::vector<std::pair<SymbolSet, uint32_t>>> symbolEdges_;
+    std::vector<std::vector<EpsilonEdge>> epsilonEdges_;
+
+    uint32_t newState() {
+        regions_.push_back(region_);
+        symbolEdges_.emplace_back();
+        epsilonEdges_.emplace_back();
+        return static_cast<uint32_t>(regions_.size() - 1);
+    }
+
+    void epsilon(uint32_t from, uint32_t to, Op op = Op::PLAIN, uint32_t counter = 0) {
+        epsilonEdges_[from].push_back({to, op, counter});
+    }
+
+    // Repetition counts as the parser expands them: min copies, then
+    // optional ones up to max; {m,} counts min and adds a star
+    static uint32_t countedCopies(const RegexParser::ASTNode& node) {
+        if (node.maxRepeat < 0) return static_cast<uint32_t>(node.minRepeat);
+        return static_cast<uint32_t>(std::max(node.minRepeat, node.maxRepeat));
+    }
+
+    bool useCounter(uint32_t copies, const Plan& child) const {
+        return copies > 1 && !child.hasCounter && child.states * copies > unrollLimit_;
+    }
+
+    Plan plan(const Node& node) const {
+        if (!node) return {2, false};
+        switch (node->type) {
+            case NodeType::UNION:
+            case NodeType::CONCAT: {
+                Plan result{node->type == NodeType::UNION ? size_t{2} : size_t{0}, false};
+                for (const auto& child : node->children) {
+                    Plan c = plan(child);
+                    result.states += c.states;
+                    result.hasCounter |= c.hasCounter;
+                }
+                return result;
+            }
+            case NodeType::STAR:
+            case NodeType::PLUS:
+            case NodeType::OPTIONAL: {
+                Plan a = plan(node->children[0]);
+                return {a.states + 2, a.hasCounter};
+            }
+            case NodeType::GROUP:
+                return plan(node->children[0]);
+            case NodeType::REPEAT_N: {
+                if (node->minRepeat == 0 && node->maxRepeat == 0) return {2, false};
+                Plan child = plan(node->children[0]);
+                uint32_t copies = countedCopies(*node);
+                bool counter = useCounter(copies, child);
+                size_t states = counter ? child.states + 2 : (child.states + 2) * copies;
+                if (node->maxRepeat < 0) states += child.states + 2;
+                return {states, child.hasCounter || counter};
+            }
+            default:
+                return {2, false};
+        }
+    }
+
+    Fragment symbols(const SymbolSet& set) {
+        Fragment f{newState(), newState()};
+        symbolEdges_[f.start].emplace_back(set, f.end);
+        return f;
+    }
+
+    Fragment empty() {
+        Fragment f{newState(), newState()};
+        epsilon(f.start, f.end);
+        return f;
+    }
+
+    Fragment concat(const Fragment& a, const Fragment& b) {
+        if (reversed_) {
+            epsilon(b.end, a.start);
+            return {b.start, a.end};
+        }
+        epsilon(a.end, b.start);
+        return {a.start, b.end};
+    }
+
+    Fragment star(const Fragment& a, bool skip) {
+        Fragment f{newState(), newState()};
+        epsilon(f.start, a.start);
+        if (skip) epsilon(f.start, f.end);
+        epsilon(a.end, a.start);
+        epsilon(a.end, f.end);
+        return f;
+    }
+
+    Fragment optional(const Fragment& a) {
+        Fragment f{newState(), newState()};
+        epsilon(f.start, a.start);
+        epsilon(f.start, f.end);
+        epsilon(a.end, f.end);
+        return f;
+    }
+
+    // One copy of the body with a counter over [min, max] iterations
+    Fragment counted(const Node& body, uint32_t min, uint32_t max) {
+        uint32_t id = static_cast<uint32_t>(program_.counters.size());
+        program_.counters.push_back({min, max});
+        Fragment f{newState(), newState()};
+
+        int32_t outer = region_;
+        region_ = static_cast<int32_t>(id);
+        Fragment inner = build(body);
+        region_ = outer;
+
+        epsilon(f.start, inner.start, Op::ENTER, id);
+        epsilon(inner.end, inner.start, Op::LOOP, id);
+        epsilon(inner.end, f.end, Op::EXIT, id);
+        if (min == 0) epsilon(f.start, f.end);
+        return f;
+    }
+
+    Fragment build(const Node& node) {
+        if (!node) return empty();
+        switch (node->type) {
+            case NodeType::CHAR: {
+                SymbolSet set;
+                set.add(node->value);
+                return symbols(set);
+            }
+            case NodeType::ANY: {
+                SymbolSet printable;
+                printable.addRange(' ', '~');
+                return symbols(printable);
+            }
+            case NodeType::CHAR_CLASS: {
+                SymbolSet set;
+                for (char c : node->charClass) set.add(c);
+                return set.empty() ? empty() : symbols(set);
+            }
+            case NodeType::UNION: {
+                std::vector<Fragment> alternatives;
+                for (const auto& child : node->children) alternatives.push_back(build(child));
+                Fragment f{newState(), newState()};
+                for (const auto& a : alternatives) {
+                    epsilon(f.start, a.start);
+                    epsilon(a.end, f.end);
+                }
+                return f;
+            }
+            case NodeType::CONCAT: {
+                Fragment result = build(node->children[0]);
+                for (size_t i = 1; i < node->children.size(); ++i) {
+                    result = concat(result, build(node->children[i]));
+                }
+                return result;
+            }
+            case NodeType::STAR:
+                return star(build(node->children[0]), true);
+            case NodeType::PLUS:
+                return star(build(node->children[0]), false);
+            case NodeType::OPTIONAL:
+                return optional(build(node->children[0]));
+            case NodeType::GROUP:
+                return build(node->children[0]);
+            case NodeType::REPEAT_N:
+                return repeat(*node);
+            default:
+                // EPSILON and the zero-width anchors, as in RegexParser
+                return empty();
+        }
+    }
+
+    Fragment repeat(const RegexParser::ASTNode& node) {
+        if (node.minRepeat == 0 && node.maxRepeat == 0) return empty();
+        const Node& body = node.children[0];
+        const uint32_t min = static_cast<uint32_t>(node.minRepeat);
+        const uint32_t copies = countedCopies(node);
+
+        std::optional<Fragment> result;
+        auto append = [&](const Fragment& part) {
+            result = result ? concat(*result, part) : part;
+        };
+        if (useCounter(copies, plan(body))) {
+            append(counted(body, min, copies));
+        } else {
+            for (uint32_t i = 0; i < copies; ++i) {
+                append(i < min ? build(body) : optional(build(body)));
+            }
+        }
+        if (node.maxRepeat < 0) append(star(build(body), true));
+        return *result;
+    }
+};
+
+CountingMatcher::CountingMatcher(const std::string& pattern) : CountingMatcher(pattern, Options()) {}
+
+CountingMatcher::CountingMatcher(const std::string& pattern, const Options& options) : options_(options) {
+    RegexParser parser;
+    auto ast = RegexOptimizer::optimize(parser.parseAST(pattern));
+    Compiler(forward_, options_.unrollLimit, false).compile(ast);
+    Compiler(reverse_, options_.unrollLimit, true).compile(ast);
+}
+
+// bits holds count words; those past it are zero
+bool CountingMatcher::merge(const Program& program, Threads& threads, uint32_t q, const uint64_t* bits,
+                            uint32_t count) {
+    uint64_t any = 0;
+    for (uint32_t w = 0; w < count; ++w) any |= bits[w];
+    if (!any) return false;
+
+    uint64_t* target = &threads.words[program.wordStart[q]];
+    uint32_t& used = threads.used[q];
+    if (threads.states.insert(q)) used = 0;
+    bool changed = false;
+    const uint32_t overlap = std::min(used, count);
+    for (uint32_t w = 0; w < overlap; ++w) {
+        uint64_t merged = target[w] | bits[w];
+        changed |= merged != target[w];
+        target[w] = merged;
+    }
+    for (uint32_t w = overlap; w < count; ++w) {
+        target[w] = bits[w];
+        changed |= bits[w] != 0;
+    }
+    used = std::max(used, count);
+    return changed;
+}
+
+void CountingMatcher::closure(const Program& program, Threads& threads) {
+    // Count vectors only grow, so re-queueing a state whenever its vector
+    // changes reaches a fixpoint even for bodies that match the empty string
+    while (!threads.pending.empty()) {
+        const uint32_t q = threads.pending.back();
+        threads.pending.pop_back();
+        const uint64_t* value = &threads.words[program.wordStart[q]];
+        const uint32_t used = threads.used[q];
+
+        for (uint32_t e = program.epsilonStart[q]; e < program.epsilonStart[q + 1]; ++e) {
+            const EpsilonEdge& edge = program.epsilonEdges[e];
+            const uint64_t* bits = value;
+            uint32_t count = used;
+            auto& scratch = threads.scratch;
+            switch (edge.op) {
+                case Op::PLAIN:
+                    break;
+                case Op::ENTER:
+                    scratch.assign(1, 1);
+                    bits = scratch.data();
+                    count = 1;
+                    break;
+                case Op::LOOP: {
+                    // Shift left by one; counts that reach max cannot go round again
+                    const uint32_t max = program.counters[edge.counter].max;
+                    const uint32_t width = program.wordStart[q + 1] - program.wordStart[q];
+                    count = std::min(used + static_cast<uint32_t>(value[used - 1] >> 63), width);
+                    scratch.resize(count);
+                    for (uint32_t w = 0; w < count; ++w) {
+                        scratch[w] = (w < used ? value[w] << 1 : 0) | (w > 0 ? value[w - 1] >> 63 : 0);
+                    }
+                    if (count == width && max % 64) scratch[width - 1] &= (uint64_t{1} << (max % 64)) - 1;
+                    bits = scratch.data();
+                    break;
+                }
+                case Op::EXIT: {
+                    // Bit c means c + 1 iterations once this one is done
+                    const Counter& counter = program.counters[edge.counter];
+                    const uint32_t lo = counter.min > 0 ? counter.min - 1 : 0;
+                    uint64_t allowed = 0;
+                    for (uint32_t w = lo >> 6; w < used; ++w) {
+                        uint64_t word = value[w];
+                        if (w == lo >> 6) word &= ~uint64_t{0} << (lo & 63);
+                        allowed |= word;
+                    }
+                    if (!allowed) continue;
+                    scratch.assign(1, 1);
+                    bits = scratch.data();
+                    count = 1;
+                    break;
+                }
+            }
+            if (merge(program, threads, edge.to, bits, count)) threads.pending.push_back(edge.to);
+        }
+    }
+}
+
+void CountingMatcher::step(const Program& program, const Threads& current, unsigned char byte, Threads& next) {
+    next.states.clear();
+    next.pending.clear();
+    const auto symbol = static_cast<Symbol>(byte);
+    for (uint32_t q : current.states) {
+        const uint64_t* value = &current.words[program.wordStart[q]];
+        const uint32_t used = current.used[q];
+        for (uint32_t e = program.symbolStart[q]; e < program.symbolStart[q + 1]; ++e) {
+            const auto& [set, to] = program.symbolEdges[e];
+            if (set.contains(symbol) && merge(program, next, to, value, used)) next.pending.push_back(to);
+        }
+    }
+    closure(program, next);
+}
+
+void CountingMatcher::addStart(const Program& program, Threads& threads) {
+    const uint64_t one = 1;
+    if (merge(program, threads, program.start, &one, 1)) {
+        threads.pending.push_back(program.start);
+        closure(program, threads);
+    }
+}
+
+template <typename Visit>
+void CountingMatcher::scan(const Program& program, const unsigned char* data, size_t begin, size_t end,
+                           bool backward, bool restart, Visit visit) {
+    size_t offset = backward ? end : begin;
+    const size_t stop = backward ? begin : end;
+
+    Threads current(program);
+    Threads next(program);
+    addStart(program, current);
+    if (current.states.contains(program.accept) && !visit(offset)) return;
+
+    while (offset != stop) {
+        unsigned char byte = backward ? data[offset - 1] : data[offset];
+        offset = backward ? offset - 1 : offset + 1;
+        step(program, current, byte, next);
+        if (restart) addStart(program, next);
+        std::swap(current, next);
+
+        if (current.states.empty()) return;
+        if (current.states.contains(program.accept) && !visit(offset)) return;
+    }
+}
+
+bool CountingMatcher::accepts(const std::string& input) const {
+    const auto* data = reinterpret_cast<const unsigned char*>(input.data());
+    bool accepted = false;
+    scan(forward_, data, 0, input.size(), false, false, [&](size_t offset) {
+        accepted = offset == input.size();
+        return true;
+    });
+    return accepted;
+}
+
+std::vector<CountingMatcher::Match> CountingMatcher::findAll(const std::string& text, MatchKind kind) const {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t length = text.size();
+    std::vector<Match> matches;
+
+    if (kind == MatchKind::ALL_OVERLAPPING) {
+        // Σ*L reports every match end; reverse(L) from each end reports its starts
+        scan(forward_, data, 0, length, false, true, [&](size_t end) {
+            scan(reverse_, data, 0, end, true, false, [&](size_t start) {
+                matches.emplace_back(start, end);
+                return true;
+            });
+            return true;
+        });
+        std::sort(matches.begin(), matches.end());
+        return matches;
+    }
+
+    // Σ*·reverse(L) scanned backwards reports every match start (descending)
+    std::vector<size_t> starts;
+    scan(reverse_, data, 0, length, true, true, [&](size_t start) {
+        starts.push_back(start);
+        return true;
+    });
+    std::reverse(starts.begin(), starts.end());
+
+    const bool longest = kind == MatchKind::LEFTMOST_LONGEST;
+    size_t pos = 0;
+    for (size_t start : starts) {
+        if (start < pos) continue;
+        size_t end = start;
+        scan(forward_, data, start, length, false, false, [&](size_t offset) {
+            end = offset;
+            return longest;
+        });
+        matches.emplace_back(start, end);
+        pos = end > start ? end : start + 1;
+    }
+    return matches;
+}
+
+} // namespace automata
@@ -1,4 +1,7 @@
 #include "automata/dfa.hpp"
+#include "automata/compiled_dfa.hpp"
+#include "automata/dfa_search.hpp"
+#include "automata/frozen_nfa.hpp"
 #include "automata/json_serializer.hpp"
 
 namespace automata {
@@ -10,6 +13,7 @@ StateId DFA::addState(const std::string& label, bool isAccepting) {
     states_.emplace(id, State(id, label, isAccepting, states_.empty()));
     if (states_.size() == 1) startState_ = id;
     if (isAccepting) acceptingStates_.insert(id);
+    invalidateCaches();
     return id;
 }
 
@@ -18,6 +22,7 @@ void DFA::setStartState(StateId id) {
     if (startState_ >= 0 && states_.count(startState_)) states_.at(startState_).setStart(false);
     startState_ = id;
     states_.at(id).setStart(true);
+    invalidateCaches();
 }
 
 void DFA::setAcceptingState(StateId id, bool accepting) {
@@ -25,6 +30,7 @@ void DFA::setAcceptingState(StateId id, bool accepting) {
     states_.at(id).setAccepting(accepting);
     if (accepting) acceptingStates_.insert(id);
     else acceptingStates_.erase(id);
+    invalidateCaches();
 }
 
 void DFA::addTransition(StateId from, StateId to, Symbol symbol) {
@@ -37,6 +43,8 @@ void DFA::addTransition(StateId from, StateId to, Symbol symbol) {
     transitions_.emplace_back(from, to, symbol);
     transitionTable_[key] = to;
     alphabet_.insert(symbol);
+    byteClasses_.reset();
+    invalidateCaches();
 }
 
 std::optional<StateId> DFA::getNextState(StateId from, Symbol symbol) const {
@@ -47,13 +55,7 @@ std::optional<StateId> DFA::getNextState(StateId from, Symbol symbol) const {
 
 bool DFA::accepts(const std::string& input) const {
     if (startState_ < 0) return false;
-    StateId current = startState_;
-    for (char c : input) {
-        auto next = getNextState(current, c);
-        if (!next) return false;
-        current = *next;
-    }
-    return acceptingStates_.count(current) > 0;
+    return getCompiled()->accepts(input);
 }
 
 std::vector<DFA::ExecutionStep> DFA::traceExecution(const std::string& input) const {
@@ -74,15 +76,53 @@ std::vector<DFA::ExecutionStep> DFA::traceExecution(const std::string& input) co
 }
 
 std::vector<std::pair<size_t, size_t>> DFA::findAllMatches(const std::string& text) const {
+    auto matches = findAllMatches(text, MatchKind::ALL_OVERLAPPING);
+    // The empty match at the very end of the text is not reported
+    if (!matches.empty() && matches.back().first == text.size()) matches.pop_back();
+    return matches;
+}
+
+std::vector<std::pair<size_t, size_t>> DFA::findAllMatches(const std::string& text, MatchKind kind) const {
+    auto& slot = searchers_[static_cast<size_t>(kind)];
+    auto searcher = std::atomic_load(&slot);
+    if (!searcher) {
+        std::optional<DFASearcher> built;
+        try {
+            built.emplace(*this, kind);
+        } catch (const AutomataException&) {
+            // Σ* prefix blew up; fall back to restarting below
+        }
+        searcher = std::make_shared<const std::optional<DFASearcher>>(std::move(built));
+        std::atomic_store(&slot, searcher);
+    }
+    if (*searcher) return (*searcher)->findAll(text);
+
+    // Restart the anchored automaton at every position: O(n·m), but no
+    // automaton beyond this one
+    auto compiled = getCompiled();
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t length = text.size();
     std::vector<std::pair<size_t, size_t>> matches;
-    for (size_t i = 0; i < text.size(); ++i) {
-        StateId current = startState_;
-        if (acceptingStates_.count(current)) matches.emplace_back(i, i);
-        for (size_t j = i; j < text.size(); ++j) {
-            auto next = getNextState(current, text[j]);
-            if (!next) break;
-            current = *next;
-            if (acceptingStates_.count(current)) matches.emplace_back(i, j + 1);
+    size_t start = 0;
+    while (start <= length) {
+        CompiledDFA::Index state = compiled->getStartState();
+        size_t matchesBefore = matches.size();
+        if (compiled->isAccepting(state)) matches.emplace_back(start, start);
+        for (size_t j = start; j < length && state != CompiledDFA::DEAD; ++j) {
+            if (kind == MatchKind::LEFTMOST_SHORTEST && matches.size() > matchesBefore) break;
+            state = compiled->next(state, bytes[j]);
+            if (!compiled->isAccepting(state)) continue;
+            if (kind == MatchKind::LEFTMOST_LONGEST && matches.size() > matchesBefore) {
+                matches.back().second = j + 1;
+            } else {
+                matches.emplace_back(start, j + 1);
+            }
+        }
+        if (kind == MatchKind::ALL_OVERLAPPING || matches.size() == matchesBefore) {
+            ++start;
+        } else {
+            const size_t end = matches.back().second;
+            start = end > start ? end : start + 1;
         }
     }
     return matches;
@@ -90,6 +130,25 @@ std::vector<std::pair<size_t, size_t>> DFA::findAllMatches(const std::string& te
 
 std::set<Symbol> DFA::getAlphabet() const { return alphabet_; }
 
+ByteClasses DFA::getByteClasses() const {
+    return byteClasses_ ? *byteClasses_ : ByteClasses::fromDFA(*this);
+}
+
+std::shared_ptr<const CompiledDFA> DFA::getCompiled() const {
+    // Concurrent readers may both compile; either result is the same table
+    auto compiled = std::atomic_load(&compiled_);
+    if (!compiled) {
+        compiled = std::make_shared<const CompiledDFA>(CompiledDFA::fromDFA(*this));
+        std::atomic_store(&compiled_, compiled);
+    }
+    return compiled;
+}
+
+void DFA::invalidateCaches() {
+    compiled_.reset();
+    for (auto& searcher : searchers_) searcher.reset();
+}
+
 std::string DFA::toString() const {
     std::ostringstream oss;
     oss << "DFA:\n  States: ";
@@ -112,82 +171,158 @@ std::string DFA::toJson() const {
 }
 
 DFA DFA::fromNFA(const NFA& nfa) {
+    return fromNFA(nfa, CompiledDFA::UNLIMITED);
+}
+
+DFA DFA::fromNFA(const NFA& nfa, size_t maxStates) {
     DFA dfa;
     std::set<Symbol> alphabet = nfa.getAlphabet();
-    std::map<std::set<StateId>, StateId> stateMap;
-    std::queue<std::set<StateId>> workList;
-    std::set<StateId> initial = nfa.epsilonClosure(nfa.getStartState());
-    bool isAccepting = false;
-    for (StateId s : initial) if (nfa.getAcceptingStates().count(s)) { isAccepting = true; break; }
-    StateId dfaStart = dfa.addState("", isAccepting);
+    ByteClasses classes = ByteClasses::fromNFA(nfa);
+    FrozenNFA frozen = nfa.freeze();
+    SparseSet scratch(frozen.getStateCount());
+    std::map<std::vector<FrozenNFA::Index>, StateId> stateMap;
+    std::queue<std::vector<FrozenNFA::Index>> workList;
+    std::vector<FrozenNFA::Index> initial = frozen.initialStates(scratch);
+    StateId dfaStart = dfa.addState("", frozen.anyAccepting(initial));
     dfa.setStartState(dfaStart);
     stateMap[initial] = dfaStart;
     workList.push(initial);
+    std::vector<StateId> classTarget(classes.getClassCount());
+    std::vector<FrozenNFA::Index> next;
     while (!workList.empty()) {
-        std::set<StateId> current = workList.front(); workList.pop();
+        std::vector<FrozenNFA::Index> current = std::move(workList.front()); workList.pop();
         StateId currentDfa = stateMap[current];
-        for (Symbol symbol : alphabet) {
-            std::set<StateId> next = nfa.epsilonClosure(nfa.move(current, symbol));
-            if (next.empty()) continue;
-            if (stateMap.find(next) == stateMap.end()) {
-                isAccepting = false;
-                for (StateId s : next) if (nfa.getAcceptingStates().count(s)) { isAccepting = true; break; }
-                stateMap[next] = dfa.addState("", isAccepting);
+        // One move/closure per class; every member of a class has the same target
+        for (size_t cls = 1; cls < classes.getClassCount(); ++cls) {
+            frozen.move(current, classes.getRepresentative(cls), next, scratch);
+            frozen.epsilonClosure(next, scratch);
+            if (next.empty()) { classTarget[cls] = -1; continue; }
+            auto it = stateMap.find(next);
+            if (it == stateMap.end()) {
+                if (stateMap.size() >= maxStates) {
+                    throw AutomataException("Subset construction exceeds " + std::to_string(maxStates) + " DFA states");
+                }
+                it = stateMap.emplace(next, dfa.addState("", frozen.anyAccepting(next))).first;
                 workList.push(next);
             }
-            dfa.addTransition(currentDfa, stateMap[next], symbol);
+            classTarget[cls] = it->second;
+        }
+        for (Symbol symbol : alphabet) {
+            StateId target = classTarget[classes.get(symbol)];
+            if (target >= 0) dfa.addTransition(currentDfa, target, symbol);
         }
     }
+    dfa.byteClasses_ = classes;
     return dfa;
 }
 
 DFA DFA::minimize() const {
     if (states_.empty()) return *this;
-    std::set<StateId> accepting, nonAccepting;
-    for (const auto& [id, state] : states_) {
-        if (state.isAccepting()) accepting.insert(id);
-        else nonAccepting.insert(id);
+
+    // Dense numbering; index n is an explicit sink standing in for missing transitions
+    std::vector<StateId> ids;
+    std::map<StateId, int> index;
+    for (const auto& [id, state] : states_) { index[id] = static_cast<int>(ids.size()); ids.push_back(id); }
+    const int n = static_cast<int>(ids.size()), total = n + 1, sink = n;
+
+    // One splitter symbol per alphabet class; class 0 labels nothing and never splits
+    ByteClasses classes = getByteClasses();
+    const int k = static_cast<int>(classes.getClassCount()) - 1;
+    std::vector<int> delta(static_cast<size_t>(total) * k, sink);
+    for (const auto& t : transitions_) {
+        delta[static_cast<size_t>(index[t.getFrom()]) * k + classes.get(t.getSymbol()) - 1] = index[t.getTo()];
+    }
+
+    // Inverse transition lists in CSR form, keyed by (target, class)
+    std::vector<int> invStart(static_cast<size_t>(total) * k + 1, 0), inv(static_cast<size_t>(total) * k);
+    for (int q = 0; q < total; ++q)
+        for (int c = 0; c < k; ++c) ++invStart[static_cast<size_t>(delta[static_cast<size_t>(q) * k + c]) * k + c + 1];
+    for (size_t i = 1; i < invStart.size(); ++i) invStart[i] += invStart[i - 1];
+    {
+        std::vector<int> fill(invStart.begin(), invStart.end() - 1);
+        for (int q = 0; q < total; ++q)
+            for (int c = 0; c < k; ++c) inv[fill[static_cast<size_t>(delta[static_cast<size_t>(q) * k + c]) * k + c]++] = q;
     }
-    std::vector<std::set<StateId>> partition;
-    if (!accepting.empty()) partition.push_back(accepting);
-    if (!nonAccepting.empty()) partition.push_back(nonAccepting);
-    std::vector<std::set<StateId>> workList = partition;
+
+    // Partition as a permutation of states: block b owns elems[first[b], end[b]),
+    // and states marked during a refinement step are swapped to the block front
+    std::vector<int> elems(total), loc(total), blockOf(total), first, end, marked;
+    int pos = 0;
+    for (int accepting = 1; accepting >= 0; --accepting) {
+        int begin = pos;
+        for (int q = 0; q < total; ++q) {
+            bool isAcc = q != sink && acceptingStates_.count(ids[q]);
+            if (isAcc != static_cast<bool>(accepting)) continue;
+            elems[pos] = q; loc[q] = pos; blockOf[q] = static_cast<int>(first.size()); ++pos;
+        }
+        if (pos > begin) { first.push_back(begin); end.push_back(pos); marked.push_back(0); }
+    }
+
+    // Worklist of (block, class) splitters; the smaller initial block suffices
+    std::vector<std::pair<int, int>> workList;
+    std::vector<std::vector<bool>> inWorkList(first.size(), std::vector<bool>(k, false));
+    auto enqueue = [&](int b, int c) { if (!inWorkList[b][c]) { inWorkList[b][c] = true; workList.emplace_back(b, c); } };
+    if (first.size() == 2) {
+        int smaller = (end[0] - first[0]) <= (end[1] - first[1]) ? 0 : 1;
+        for (int c = 0; c < k; ++c) enqueue(smaller, c);
+    }
+
+    std::vector<int> touched, splitter;
     while (!workList.empty()) {
-        std::set<StateId> A = workList.back(); workList.pop_back();
-        for (Symbol c : alphabet_) {
-            std::set<StateId> X;
-            for (const auto& [id, state] : states_) {
-                auto next = getNextState(id, c);
-                if (next && A.count(*next)) X.insert(id);
-            }
-            std::vector<std::set<StateId>> newPartition;
-            for (const auto& Y : partition) {
-                std::set<StateId> intersection, difference;
-                for (StateId s : Y) { if (X.count(s)) intersection.insert(s); else difference.insert(s); }
-                if (!intersection.empty() && !difference.empty()) {
-                    newPartition.push_back(intersection); newPartition.push_back(difference);
-                    auto it = std::find(workList.begin(), workList.end(), Y);
-                    if (it != workList.end()) { workList.erase(it); workList.push_back(intersection); workList.push_back(difference); }
-                    else workList.push_back(intersection.size() <= difference.size() ? intersection : difference);
-                } else newPartition.push_back(Y);
+        auto [a, c] = workList.back(); workList.pop_back();
+        inWorkList[a][c] = false;
+        splitter.assign(elems.begin() + first[a], elems.begin() + end[a]);
+        for (int q : splitter) {
+            size_t key = static_cast<size_t>(q) * k + c;
+            for (int i = invStart[key]; i < invStart[key + 1]; ++i) {
+                int p = inv[i], b = blockOf[p];
+                if (loc[p] < first[b] + marked[b]) continue;
+                if (marked[b] == 0) touched.push_back(b);
+                int dest = first[b] + marked[b]++;
+                std::swap(elems[loc[p]], elems[dest]);
+                loc[elems[loc[p]]] = loc[p]; loc[p] = dest;
             }
-            partition = newPartition;
         }
+        for (int b : touched) {
+            int m = marked[b]; marked[b] = 0;
+            if (m == end[b] - first[b]) continue;
+            // Split off the marked prefix as a new block
+            int nb = static_cast<int>(first.size());
+            first.push_back(first[b]); end.push_back(first[b] + m); marked.push_back(0);
+            first[b] += m;
+            for (int i = first[nb]; i < end[nb]; ++i) blockOf[elems[i]] = nb;
+            inWorkList.emplace_back(k, false);
+            int smaller = (end[nb] - first[nb]) <= (end[b] - first[b]) ? nb : b;
+            for (int cc = 0; cc < k; ++cc) enqueue(inWorkList[b][cc] ? nb : smaller, cc);
+        }
+        touched.clear();
     }
+
+    // Build the quotient over blocks reachable from the start; the sink's block
+    // (states that can never accept) becomes implicit again
+    const int sinkBlock = blockOf[sink];
+    std::vector<int> newId(first.size(), -1), order;
     DFA minDfa;
-    std::map<StateId, StateId> stateToPartition;
-    for (size_t i = 0; i < partition.size(); ++i) {
-        bool isAcc = false;
-        for (StateId s : partition[i]) { stateToPartition[s] = i; if (acceptingStates_.count(s)) isAcc = true; }
-        minDfa.addState("", isAcc);
-    }
-    minDfa.setStartState(stateToPartition[startState_]);
-    std::set<std::tuple<StateId, StateId, Symbol>> added;
-    for (const auto& t : transitions_) {
-        StateId from = stateToPartition[t.getFrom()], to = stateToPartition[t.getTo()];
-        auto key = std::make_tuple(from, to, t.getSymbol());
-        if (added.find(key) == added.end()) { minDfa.addTransition(from, to, t.getSymbol()); added.insert(key); }
+    auto visit = [&](int b) {
+        if (newId[b] >= 0) return;
+        newId[b] = static_cast<int>(order.size());
+        order.push_back(b);
+        minDfa.addState("", b != sinkBlock && acceptingStates_.count(ids[elems[first[b]]]) > 0);
+    };
+    visit(blockOf[index[startState_]]);
+    minDfa.setStartState(0);
+    if (order[0] == sinkBlock) return minDfa;
+    for (size_t i = 0; i < order.size(); ++i) {
+        int rep = elems[first[order[i]]];
+        for (Symbol s : alphabet_) {
+            int target = blockOf[delta[static_cast<size_t>(rep) * k + classes.get(s) - 1]];
+            if (target == sinkBlock) continue;
+            visit(target);
+            minDfa.addTransition(static_cast<StateId>(i), newId[target], s);
+        }
     }
+    // Merging states never separates two bytes, so the classes still hold
+    minDfa.byteClasses_ = classes;
     return minDfa;
 }
 
@@ -202,6 +337,7 @@ std::vector<DFA::GrammarRule> DFA::toRegularGrammar() const {
 DFA DFA::complement() const {
     DFA result = *this;
     result.acceptingStates_.clear();
+    result.invalidateCaches();
     for (const auto& [id, state] : result.states_) {
         if (!acceptingStates_.count(id)) result.setAcceptingState(id, true);
         else result.states_.at(id).setAccepting(false);
@@ -0,0 +1,202 @@
+#include "automata/dfa_search.hpp"
+#include "automata/regex_parser.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+namespace automata {
+
+namespace {
+
+// Average text bytes per candidate region below which the prefilter is skipped
+constexpr size_t MIN_REGION_SPACING = 1024;
+
+} // namespace
+
+DFASearcher::DFASearcher(const DFA& dfa, MatchKind kind)
+    : DFASearcher(*dfa.getCompiled(), kind, Options()) {}
+
+DFASearcher::DFASearcher(const DFA& dfa, MatchKind kind, const Options& options)
+    : DFASearcher(*dfa.getCompiled(), kind, options) {}
+
+DFASearcher::DFASearcher(const CompiledDFA& dfa, MatchKind kind)
+    : DFASearcher(dfa, kind, Options()) {}
+
+DFASearcher::DFASearcher(const CompiledDFA& dfa, MatchKind kind, const Options& options) : kind_(kind) {
+    if (kind == MatchKind::ALL_OVERLAPPING) {
+        forward_ = dfa.unanchored(options.maxStates);
+        reverse_ = dfa.reversed(false, options.maxStates);
+    } else {
+        forward_ = dfa;
+        reverse_ = dfa.reversed(true, options.maxStates);
+    }
+
+    const CompiledDFA& scanned = kind == MatchKind::ALL_OVERLAPPING ? forward_ : reverse_;
+    if (ShuffleDFA::fits(scanned)) scanner_ = ShuffleDFA::fromCompiled(scanned);
+    else if (StridedDFA::fits(scanned, 4)) strided_ = StridedDFA::fromCompiled(scanned, 4);
+}
+
+DFASearcher DFASearcher::fromPattern(const std::string& pattern, MatchKind kind) {
+    return fromPattern(pattern, kind, Options());
+}
+
+DFASearcher DFASearcher::fromPattern(const std::string& pattern, MatchKind kind, const Options& options) {
+    RegexParser parser;
+    NFA nfa = parser.parse(pattern);
+    DFASearcher searcher(DFA::fromNFA(nfa, options.maxStates).minimize(), kind, options);
+    if (!pattern.empty()) searcher.prefilter_ = LiteralPrefilter::fromAST(parser.getAST());
+    return searcher;
+}
+
+std::vector<DFASearcher::Match> DFASearcher::findAll(const std::string& text) const {
+    return findAll(text.data(), text.size());
+}
+
+std::vector<DFASearcher::Match> DFASearcher::findAll(const char* data, size_t length) const {
+    const auto* text = reinterpret_cast<const unsigned char*>(data);
+    if (!prefilter_) return findInText(text, length);
+
+    // Matches never straddle regions, so each one is searched on its own.
+    // Dense hits make per-region overhead exceed a plain scan of the text.
+    auto regions = prefilter_->candidateRegions(data, length, length / MIN_REGION_SPACING);
+    if (!regions) return findInText(text, length);
+    size_t covered = 0;
+    for (const auto& [begin, end] : *regions) covered += end - begin;
+    if (covered * 2 > length) return findInText(text, length);
+
+    std::vector<Match> matches;
+    for (const auto& [begin, end] : *regions) {
+        for (const auto& [start, stop] : findInText(text + begin, end - begin)) {
+            matches.emplace_back(begin + start, begin + stop);
+        }
+    }
+    return matches;
+}
+
+std::vector<DFASearcher::Match> DFASearcher::findInText(const unsigned char* text, size_t length) const {
+    if (kind_ == MatchKind::ALL_OVERLAPPING) return findOverlapping(text, length);
+    return findLeftmost(text, length);
+}
+
+std::vector<DFASearcher::Match> DFASearcher::findOverlapping(const unsigned char* text, size_t length) const {
+    std::vector<Match> matches;
+    auto collectStarts = [&](size_t end) {
+        CompiledDFA::Index state = reverse_.getStartState();
+        if (reverse_.isAccepting(state)) matches.emplace_back(end, end);
+        for (size_t p = end; p > 0; --p) {
+            state = reverse_.next(state, text[p - 1]);
+            if (state == CompiledDFA::DEAD) break;
+            if (reverse_.isAccepting(state)) matches.emplace_back(p - 1, end);
+        }
+    };
+
+    // Single forward pass: Σ*L is accepting exactly at match ends
+    if (scanner_ || strided_) {
+        std::vector<size_t> ends;
+        if (scanner_) scanner_->findAccepting(reinterpret_cast<const char*>(text), length, false, ends);
+        else strided_->findAccepting(reinterpret_cast<const char*>(text), length, false, ends);
+        for (size_t end : ends) collectStarts(end);
+        std::sort(matches.begin(), matches.end());
+        return matches;
+    }
+
+    CompiledDFA::Index state = forward_.getStartState();
+    if (forward_.isAccepting(state)) collectStarts(0);
+    for (size_t i = 0; i < length; ++i) {
+        state = forward_.next(state, text[i]);
+        if (forward_.isAccepting(state)) collectStarts(i + 1);
+    }
+
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+std::vector<DFASearcher::Match> DFASearcher::findLeftmost(const unsigned char* text, size_t length) const {
+    std::vector<Match> matches;
+
+    // Single backward pass: Σ*·reverse(L) is accepting exactly at match starts
+    std::vector<uint64_t> starts((length + 1 + 63) / 64, 0);
+    auto mark = [&starts](size_t p) { starts[p >> 6] |= uint64_t{1} << (p & 63); };
+    CompiledDFA::Index state = reverse_.getStartState();
+    if (scanner_ || strided_) {
+        std::vector<size_t> found;
+        if (scanner_) scanner_->findAccepting(reinterpret_cast<const char*>(text), length, true, found);
+        else strided_->findAccepting(reinterpret_cast<const char*>(text), length, true, found);
+        for (size_t p : found) mark(p);
+    } else {
+        if (reverse_.isAccepting(state)) mark(length);
+        for (size_t p = length; p > 0; --p) {
+            state = reverse_.next(state, text[p - 1]);
+            if (reverse_.isAccepting(state)) mark(p - 1);
+        }
+    }
+
+    auto nextStart = [&starts, length](size_t from) -> size_t {
+        size_t word = from >> 6;
+        if (word >= starts.size()) return length + 1;
+        uint64_t bits = starts[word] & (~uint64_t{0} << (from & 63));
+        while (bits == 0) {
+            if (++word == starts.size()) return length + 1;
+            bits = starts[word];
+        }
+        return (word << 6) + static_cast<size_t>(__builtin_ctzll(bits));
+    };
+
+    // A longest scan runs past its match end until the DFA dies, over text
+    // that later scans read again. What follows a (position, state) pair does
+    // not depend on where the scan began, and a scan sees no accept after its
+    // match end. So the pairs it visits past that end are remembered, and a
+    // later scan reaching one stops there. Each pair is scanned past a match
+    // at most once, which bounds the scans by O(n * states) instead of O(n^2)
+    // (e.g. A|A[ACGT]*G on a run of A).
+    const uint64_t stateCount = forward_.getStateCount();
+    auto key = [stateCount](size_t p, CompiledDFA::Index q) { return static_cast<uint64_t>(p) * stateCount + q; };
+    std::unordered_set<uint64_t> overrun;
+    size_t overrunEnd = 0;  // One past the furthest remembered position
+    std::vector<std::pair<size_t, CompiledDFA::Index>> tail;  // Scan path from the last accept on
+
+    const bool longest = kind_ == MatchKind::LEFTMOST_LONGEST;
+    size_t pos = 0;
+    while (pos <= length) {
+        size_t start = nextStart(pos);
+        if (start > length) break;
+
+        // Every marked start has a match, so the anchored scan always finds an end
+        state = forward_.getStartState();
+        size_t end = start;
+        if (longest) {
+            if (start >= overrunEnd) overrun.clear();
+            tail.clear();
+            for (size_t j = start;; ++j) {
+                // Remembered pairs never accept and lead to no accept
+                if (j < overrunEnd && overrun.count(key(j, state))) break;
+                if (forward_.isAccepting(state)) { end = j; tail.clear(); }
+                tail.emplace_back(j, state);
+                if (j == length) break;
+                state = forward_.next(state, text[j]);
+                if (state == CompiledDFA::DEAD) break;
+            }
+            // Only pairs past the end are kept; they are the ones later scans can reach
+            if (tail.size() > 1) {
+                for (const auto& [p, q] : tail) {
+                    if (p > end) overrun.insert(key(p, q));
+                }
+                overrunEnd = std::max(overrunEnd, tail.back().first + 1);
+            }
+        } else if (!forward_.isAccepting(state)) {
+            for (size_t j = start; j < length; ++j) {
+                state = forward_.next(state, text[j]);
+                if (state == CompiledDFA::DEAD) break;
+                if (forward_.isAccepting(state)) {
+                    end = j + 1;
+                    break;
+                }
+            }
+        }
+
+        matches.emplace_back(start, end);
+        pos = end > start ? end : start + 1;
+    }
+    return matches;
+}
+
+} // namespace automata
@@ -0,0 +1,282 @@
+#include "bio/edit_distance.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIO_EDIT_DISTANCE_X86
+#include <immintrin.h>
+#endif
+
+namespace bio {
+
+namespace {
+
+using Op = EditDistance::Op;
+
+// Single-row DP over the shorter string
+int distanceScalar(const char* a, size_t m, const char* b, size_t n) {
+    if (n > m) {
+        std::swap(a, b);
+        std::swap(m, n);
+    }
+    std::vector<int> row(n + 1);
+    for (size_t j = 0; j <= n; ++j) row[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= m; ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
+        for (size_t j = 1; j <= n; ++j) {
+            const int up = row[j];
+            row[j] = std::min({diagonal + (a[i - 1] != b[j - 1]), up + 1, row[j - 1] + 1});
+            diagonal = up;
+        }
+    }
+    return row[n];
+}
+
+// Anti-diagonal d holds the cells (i, d - i), indexed by i. Cell (i, j)
+// needs (i - 1, j - 1) from diagonal d - 2 and (i - 1, j), (i, j - 1) from
+// d - 1; b is reversed so that b[j - 1] = rb[n - d + i] runs forward with i.
+struct Diagonals {
+    const char* a;
+    const char* rb;
+    size_t n;
+    size_t d;
+    const int16_t* twoBack;
+    const int16_t* oneBack;
+    int16_t* current;
+
+    void cell(size_t i) const {
+        const int substitution = twoBack[i - 1] + (a[i - 1] != rb[n - d + i]);
+        const int gap = std::min(oneBack[i - 1], oneBack[i]) + 1;
+        current[i] = static_cast<int16_t>(std::min(substitution, gap));
+    }
+};
+
+#ifdef BIO_EDIT_DISTANCE_X86
+
+// Cells [i, last] of one diagonal; returns the first cell left for scalar
+__attribute__((target("sse4.1")))
+size_t diagonalSSE41(const Diagonals& g, size_t i, size_t last) {
+    const __m128i one = _mm_set1_epi16(1);
+    for (; i + 8 <= last + 1; i += 8) {
+        const __m128i ca = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(g.a + i - 1));
+        const __m128i cb = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(g.rb + g.n - g.d + i));
+        // -1 where the letters agree, so 1 + equal is the substitution cost
+        const __m128i equal = _mm_cvtepi8_epi16(_mm_cmpeq_epi8(ca, cb));
+        const __m128i diagonal = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g.twoBack + i - 1));
+        const __m128i up = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g.oneBack + i - 1));
+        const __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g.oneBack + i));
+        const __m128i substitution = _mm_add_epi16(diagonal, _mm_add_epi16(one, equal));
+        const __m128i gap = _mm_add_epi16(_mm_min_epi16(up, left), one);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(g.current + i), _mm_min_epi16(substitution, gap));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t diagonalAVX2(const Diagonals& g, size_t i, size_t last) {
+    const __m256i one = _mm256_set1_epi16(1);
+    for (; i + 16 <= last + 1; i += 16) {
+        const __m128i ca = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g.a + i - 1));
+        const __m128i cb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g.rb + g.n - g.d + i));
+        const __m256i equal = _mm256_cvtepi8_epi16(_mm_cmpeq_epi8(ca, cb));
+        const __m256i diagonal = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(g.twoBack + i - 1));
+        const __m256i up = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(g.oneBack + i - 1));
+        const __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(g.oneBack + i));
+        const __m256i substitution = _mm256_add_epi16(diagonal, _mm256_add_epi16(one, equal));
+        const __m256i gap = _mm256_add_epi16(_mm256_min_epi16(up, left), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(g.current + i), _mm256_min_epi16(substitution, gap));
+    }
+    return i;
+}
+
+#endif // BIO_EDIT_DISTANCE_X86
+
+// Distances fit in 16-bit lanes while both lengths do
+int distanceAntiDiagonal(const char* a, size_t m, const char* b, size_t n, EditDistance::Backend backend) {
+    const std::string rb(std::reverse_iterator<const char*>(b + n), std::reverse_iterator<const char*>(b));
+    std::vector<int16_t> buffers(3 * (m + 1));
+    int16_t* twoBack = buffers.data();
+    int16_t* oneBack = twoBack + (m + 1);
+    int16_t* current = oneBack + (m + 1);
+
+    for (size_t d = 0; d <= m + n; ++d) {
+        // Interior cells have i >= 1 and j >= 1
+        const size_t first = d > n ? d - n : 1;
+        const size_t last = d > 0 ? std::min(m, d - 1) : 0;
+        if (first <= last) {
+            Diagonals g{a, rb.data(), n, d, twoBack, oneBack, current};
+            size_t i = first;
+#ifdef BIO_EDIT_DISTANCE_X86
+            if (backend == EditDistance::Backend::AVX2) i = diagonalAVX2(g, i, last);
+            if (backend != EditDistance::Backend::SCALAR) i = diagonalSSE41(g, i, last);
+#else
+            (void)backend;
+#endif
+            for (; i <= last; ++i) g.cell(i);
+        }
+        if (d <= n) current[0] = static_cast<int16_t>(d);
+        if (d <= m) current[d] = static_cast<int16_t>(d);
+        std::swap(twoBack, oneBack);
+        std::swap(oneBack, current);
+    }
+    return oneBack[m];
+}
+
+// Last DP row of a against every prefix of b, or of the reversed strings
+template <bool Reverse>
+void lastRow(const char* a, size_t m, const char* b, size_t n, std::vector<int>& row) {
+    auto at = [](const char* s, size_t length, size_t i) { return Reverse ? s[length - 1 - i] : s[i]; };
+    row.resize(n + 1);
+    for (size_t j = 0; j <= n; ++j) row[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= m; ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
+        const char c = at(a, m, i - 1);
+        for (size_t j = 1; j <= n; ++j) {
+            const int up = row[j];
+            row[j] = std::min({diagonal + (c != at(b, n, j - 1)), up + 1, row[j - 1] + 1});
+            diagonal = up;
+        }
+    }
+}
+
+// Full table and backtrack from the end
+void traceback(const char* a, size_t m, const char* b, size_t n, std::vector<Op>& out) {
+    const size_t width = n + 1;
+    std::vector<int> dp((m + 1) * width);
+    for (size_t i = 0; i <= m; ++i) dp[i * width] = static_cast<int>(i);
+    for (size_t j = 0; j <= n; ++j) dp[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= m; ++i) {
+        for (size_t j = 1; j <= n; ++j) {
+            if (a[i - 1] == b[j - 1]) {
+                dp[i * width + j] = dp[(i - 1) * width + j - 1];
+            } else {
+                dp[i * width + j] = 1 + std::min({dp[(i - 1) * width + j], dp[i * width + j - 1],
+                                                  dp[(i - 1) * width + j - 1]});
+            }
+        }
+    }
+
+    const size_t begin = out.size();
+    size_t i = m, j = n;
+    while (i > 0 || j > 0) {
+        const int here = dp[i * width + j];
+        if (i > 0 && j > 0 && a[i - 1] == b[j - 1]) {
+            out.push_back(Op::MATCH);
+            --i; --j;
+        } else if (i > 0 && j > 0 && here == dp[(i - 1) * width + j - 1] + 1) {
+            out.push_back(Op::SUBSTITUTE);
+            --i; --j;
+        } else if (j > 0 && here == dp[i * width + j - 1] + 1) {
+            out.push_back(Op::INSERT);
+            --j;
+        } else {
+            out.push_back(Op::DELETE);
+            --i;
+        }
+    }
+    std::reverse(out.begin() + begin, out.end());
+}
+
+void hirschberg(const char* a, size_t m, const char* b, size_t n, std::vector<Op>& out,
+                std::vector<int>& forward, std::vector<int>& backward) {
+    if (m <= 1 || (m + 1) * (n + 1) <= EditDistance::MAX_TRACEBACK_CELLS) {
+        traceback(a, m, b, n, out);
+        return;
+    }
+    // An optimal path crosses row mid at the column minimizing the cost of
+    // the top half to it plus the cost of the bottom half from it
+    const size_t mid = m / 2;
+    lastRow<false>(a, mid, b, n, forward);
+    lastRow<true>(a + mid, m - mid, b, n, backward);
+    size_t split = 0;
+    int best = forward[0] + backward[n];
+    for (size_t j = 1; j <= n; ++j) {
+        if (forward[j] + backward[n - j] < best) {
+            best = forward[j] + backward[n - j];
+            split = j;
+        }
+    }
+    hirschberg(a, mid, b, split, out, forward, backward);
+    hirschberg(a + mid, m - mid, b + split, n - split, out, forward, backward);
+}
+
+} // namespace
+
+EditDistance::Backend EditDistance::detectBackend() {
+#ifdef BIO_EDIT_DISTANCE_X86
+    static const Backend detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Backend::AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return Backend::SSE41;
+        return Backend::SCALAR;
+    }();
+    return detected;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+int EditDistance::distance(const std::string& a, const std::string& b) {
+    return distance(a.data(), a.size(), b.data(), b.size(), detectBackend());
+}
+
+int EditDistance::distance(const char* a, size_t m, const char* b, size_t n, Backend backend) {
+    backend = std::min(backend, detectBackend());
+    if (backend == Backend::SCALAR || std::min(m, n) < MIN_SIMD_LENGTH || std::max(m, n) > INT16_MAX) {
+        return distanceScalar(a, m, b, n);
+    }
+    return distanceAntiDiagonal(a, m, b, n, backend);
+}
+
+int EditDistance::bounded(const std::string& a, const std::string& b, int k) {
+    return bounded(a.data(), a.size(), b.data(), b.size(), k);
+}
+
+int EditDistance::bounded(const char* a, size_t m, const char* b, size_t n, int k) {
+    if (k < 0) {
+        throw std::invalid_argument("Distance bound must be non-negative");
+    }
+    const int cap = k + 1;
+    const size_t band = static_cast<size_t>(k);
+    if ((m > n ? m - n : n - m) > band) return cap;
+
+    // Cells outside the band hold cap; each row only fills j in [i - k, i + k]
+    std::vector<int> previous(n + 1, cap), current(n + 1, cap);
+    for (size_t j = 0; j <= std::min(n, band); ++j) previous[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= m; ++i) {
+        const size_t lo = i > band ? i - band : 0;
+        const size_t hi = std::min(n, i + band);
+        int rowMin = cap;
+        size_t j = lo;
+        if (lo == 0) {
+            current[0] = static_cast<int>(i);
+            rowMin = current[0];
+            j = 1;
+        } else {
+            current[lo - 1] = cap;
+        }
+        for (; j <= hi; ++j) {
+            int value = previous[j - 1] + (a[i - 1] != b[j - 1]);
+            value = std::min({value, previous[j] + 1, current[j - 1] + 1, cap});
+            current[j] = value;
+            rowMin = std::min(rowMin, value);
+        }
+        // Distances never decrease along a path, so the rest cannot recover
+        if (rowMin > k) return cap;
+        previous.swap(current);
+    }
+    return std::min(previous[n], cap);
+}
+
+std::vector<EditDistance::Op> EditDistance::alignment(const std::string& a, const std::string& b) {
+    std::vector<Op> ops;
+    ops.reserve(a.size() + b.size());
+    std::vector<int> forward, backward;
+    hirschberg(a.data(), a.size(), b.data(), b.size(), ops, forward, backward);
+    return ops;
+}
+
+} // namespace bio
@@ -0,0 +1,250 @@
+#include "automata/frozen_nfa.hpp"
+
+namespace automata {
+
+FrozenNFA::FrozenNFA() : start_(0), hasStart_(false), hasClosures_(true), words_(0) {
+    epsilonStart_.assign(1, 0);
+    symbolStart_.assign(1, 0);
+}
+
+FrozenNFA FrozenNFA::fromNFA(const NFA& nfa) {
+    FrozenNFA result;
+
+    std::map<StateId, Index> index;
+    for (const auto& [id, state] : nfa.getStates()) {
+        index[id] = static_cast<Index>(result.ids_.size());
+        result.ids_.push_back(id);
+    }
+    const size_t n = result.ids_.size();
+
+    // Counting pass, then fill; symbol edges are then sorted per state.
+    // Class edges are expanded to one edge per member so lookups by symbol
+    // stay a binary search.
+    result.epsilonStart_.assign(n + 1, 0);
+    result.symbolStart_.assign(n + 1, 0);
+    for (const auto& t : nfa.getTransitions()) {
+        Index from = index.at(t.getFrom());
+        if (t.isEpsilon()) {
+            ++result.epsilonStart_[from + 1];
+        } else {
+            result.symbolStart_[from + 1] += t.isClass() ? static_cast<uint32_t>(t.getSymbols().size()) : 1;
+        }
+    }
+    for (size_t q = 0; q < n; ++q) {
+        result.epsilonStart_[q + 1] += result.epsilonStart_[q];
+        result.symbolStart_[q + 1] += result.symbolStart_[q];
+    }
+
+    result.epsilon_.resize(result.epsilonStart_[n]);
+    result.symbols_.resize(result.symbolStart_[n]);
+    std::vector<uint32_t> epsilonFill(result.epsilonStart_.begin(), result.epsilonStart_.end() - 1);
+    std::vector<uint32_t> symbolFill(result.symbolStart_.begin(), result.symbolStart_.end() - 1);
+    for (const auto& t : nfa.getTransitions()) {
+        Index from = index.at(t.getFrom());
+        Index to = index.at(t.getTo());
+        if (t.isEpsilon()) {
+            result.epsilon_[epsilonFill[from]++] = to;
+        } else if (t.isClass()) {
+            for (Symbol s : t.getSymbols().members()) result.symbols_[symbolFill[from]++] = {s, to};
+        } else {
+            result.symbols_[symbolFill[from]++] = {t.getSymbol(), to};
+        }
+    }
+    for (size_t q = 0; q < n; ++q) {
+        std::stable_sort(result.symbols_.begin() + result.symbolStart_[q],
+                         result.symbols_.begin() + result.symbolStart_[q + 1],
+                         [](const Edge& a, const Edge& b) { return a.symbol < b.symbol; });
+    }
+
+    result.accepting_.assign(n, false);
+    for (StateId s : nfa.getAcceptingStates()) result.accepting_[index.at(s)] = true;
+
+    auto start = index.find(nfa.getStartState());
+    result.hasStart_ = start != index.end();
+    result.start_ = result.hasStart_ ? start->second : 0;
+    result.buildClosureTable();
+    return result;
+}
+
+void FrozenNFA::buildClosureTable() {
+    const size_t n = ids_.size();
+    words_ = (n + 63) / 64;
+    acceptMask_.assign(words_, 0);
+    for (size_t q = 0; q < n; ++q) {
+        if (accepting_[q]) acceptMask_[q >> 6] |= uint64_t{1} << (q & 63);
+    }
+
+    closures_.clear();
+    hasClosures_ = n * words_ * sizeof(uint64_t) <= MAX_CLOSURE_TABLE_BYTES;
+    if (!hasClosures_) return;
+
+    closures_.assign(n * words_, 0);
+    SparseSet reached(n);
+    for (Index q = 0; q < n; ++q) {
+        reached.clear();
+        reached.insert(q);
+        for (size_t i = 0; i < reached.size(); ++i) {
+            for (Index to : getEpsilonEdges(reached[i])) reached.insert(to);
+        }
+        uint64_t* row = closures_.data() + q * words_;
+        for (Index r : reached) row[r >> 6] |= uint64_t{1} << (r & 63);
+    }
+}
+
+FrozenNFA::Range<FrozenNFA::Edge> FrozenNFA::getSymbolEdges(Index state, Symbol symbol) const {
+    Range<Edge> all = getSymbolEdges(state);
+    auto range = std::equal_range(all.first, all.last, Edge{symbol, 0},
+                                  [](const Edge& a, const Edge& b) { return a.symbol < b.symbol; });
+    return {range.first, range.second};
+}
+
+void FrozenNFA::epsilonClosure(std::vector<Index>& states, SparseSet& scratch) const {
+    scratch.clear();
+    for (Index q : states) scratch.insert(q);
+    // The sparse set doubles as the work list
+    for (size_t i = 0; i < scratch.size(); ++i) {
+        for (Index to : getEpsilonEdges(scratch[i])) scratch.insert(to);
+    }
+    states.assign(scratch.begin(), scratch.end());
+    std::sort(states.begin(), states.end());
+}
+
+void FrozenNFA::move(const std::vector<Index>& states, Symbol symbol, std::vector<Index>& out,
+                     SparseSet& scratch) const {
+    scratch.clear();
+    for (Index q : states) {
+        for (const Edge& e : getSymbolEdges(q, symbol)) scratch.insert(e.to);
+    }
+    out.assign(scratch.begin(), scratch.end());
+    std::sort(out.begin(), out.end());
+}
+
+bool FrozenNFA::anyAccepting(const std::vector<Index>& states) const {
+    for (Index q : states) {
+        if (accepting_[q]) return true;
+    }
+    return false;
+}
+
+std::vector<FrozenNFA::Index> FrozenNFA::initialStates(SparseSet& scratch) const {
+    std::vector<Index> states;
+    if (hasStart_) {
+        states.push_back(start_);
+        epsilonClosure(states, scratch);
+    }
+    return states;
+}
+
+std::set<StateId> FrozenNFA::toStateIds(const std::vector<Index>& states) const {
+    std::set<StateId> result;
+    for (Index q : states) result.insert(ids_[q]);
+    return result;
+}
+
+NFASimulator::NFASimulator(const FrozenNFA& nfa)
+    : nfa_(&nfa)
+    , useBits_(nfa.hasClosureTable())
+    , empty_(true)
+{
+    if (useBits_) {
+        current_.assign(nfa.getWordCount(), 0);
+        next_.assign(nfa.getWordCount(), 0);
+    } else {
+        currentSet_ = SparseSet(nfa.getStateCount());
+        nextSet_ = SparseSet(nfa.getStateCount());
+    }
+    reset();
+}
+
+void NFASimulator::reset() {
+    if (nfa_->hasStartState()) {
+        reset({nfa_->getStartState()});
+    } else {
+        reset(std::vector<FrozenNFA::Index>{});
+    }
+}
+
+void NFASimulator::reset(const std::vector<FrozenNFA::Index>& states) {
+    if (useBits_) {
+        const size_t words = nfa_->getWordCount();
+        std::fill(current_.begin(), current_.end(), 0);
+        for (FrozenNFA::Index q : states) {
+            const uint64_t* row = nfa_->getClosureRow(q);
+            for (size_t w = 0; w < words; ++w) current_[w] |= row[w];
+        }
+    } else {
+        currentSet_.clear();
+        for (FrozenNFA::Index q : states) currentSet_.insert(q);
+        closeSparse(currentSet_);
+    }
+    empty_ = states.empty();
+}
+
+bool NFASimulator::step(Symbol symbol) {
+    if (useBits_) {
+        const size_t words = nfa_->getWordCount();
+        std::fill(next_.begin(), next_.end(), 0);
+        bool any = false;
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = current_[w]; bits != 0; bits &= bits - 1) {
+                auto q = static_cast<FrozenNFA::Index>((w << 6) | static_cast<size_t>(__builtin_ctzll(bits)));
+                for (const auto& e : nfa_->getSymbolEdges(q, symbol)) {
+                    // Closures are transitive: a target already in the set
+                    // has its whole closure there too
+                    if ((next_[e.to >> 6] >> (e.to & 63)) & 1) continue;
+                    const uint64_t* row = nfa_->getClosureRow(e.to);
+                    for (size_t i = 0; i < words; ++i) next_[i] |= row[i];
+                    any = true;
+                }
+            }
+        }
+        current_.swap(next_);
+        empty_ = !any;
+    } else {
+        nextSet_.clear();
+        for (FrozenNFA::Index q : currentSet_) {
+            for (const auto& e : nfa_->getSymbolEdges(q, symbol)) nextSet_.insert(e.to);
+        }
+        closeSparse(nextSet_);
+        std::swap(currentSet_, nextSet_);
+        empty_ = currentSet_.empty();
+    }
+    return !empty_;
+}
+
+bool NFASimulator::isAccepting() const {
+    if (useBits_) {
+        const uint64_t* mask = nfa_->getAcceptMask();
+        for (size_t w = 0; w < current_.size(); ++w) {
+            if (current_[w] & mask[w]) return true;
+        }
+        return false;
+    }
+    for (FrozenNFA::Index q : currentSet_) {
+        if (nfa_->isAccepting(q)) return true;
+    }
+    return false;
+}
+
+std::vector<FrozenNFA::Index> NFASimulator::getStates() const {
+    std::vector<FrozenNFA::Index> states;
+    if (useBits_) {
+        for (size_t w = 0; w < current_.size(); ++w) {
+            for (uint64_t bits = current_[w]; bits != 0; bits &= bits - 1) {
+                states.push_back(static_cast<FrozenNFA::Index>((w << 6) | static_cast<size_t>(__builtin_ctzll(bits))));
+            }
+        }
+    } else {
+        states.assign(currentSet_.begin(), currentSet_.end());
+        std::sort(states.begin(), states.end());
+    }
+    return states;
+}
+
+void NFASimulator::closeSparse(SparseSet& set) const {
+    for (size_t i = 0; i < set.size(); ++i) {
+        for (FrozenNFA::Index to : nfa_->getEpsilonEdges(set[i])) set.insert(to);
+    }
+}
+
+} // namespace automata
@@ -0,0 +1,212 @@
+#include "bio/hamming_matcher.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIO_HAMMING_X86
+#include <immintrin.h>
+#endif
+
+namespace bio {
+
+namespace {
+
+constexpr int MAX_COUNTER_BITS = 32;
+constexpr uint16_t NO_PLANE = 0xFFFF;
+
+// Bitplanes of the text, plus a word of slack past the last AVX2 load
+struct Planes {
+    size_t words;
+    std::vector<uint64_t> bits;
+
+    const uint64_t* plane(size_t index) const { return bits.data() + index * words; }
+};
+
+// 64 plane bits starting at bit o
+inline uint64_t extract(const uint64_t* plane, size_t o) {
+    const size_t word = o / 64;
+    const unsigned shift = o % 64;
+    if (shift == 0) return plane[word];
+    return (plane[word] >> shift) | (plane[word + 1] << (64 - shift));
+}
+
+// Report the starts of one 64-start group that did not carry out
+void collect(const uint64_t* counter, int bits, uint64_t overflow, uint64_t preload,
+             size_t first, size_t windows, std::vector<HammingMatcher::Hit>& hits) {
+    uint64_t survivors = ~overflow;
+    if (first + 64 > windows) survivors &= (windows > first ? (uint64_t{1} << (windows - first)) - 1 : 0);
+    while (survivors) {
+        const unsigned s = static_cast<unsigned>(__builtin_ctzll(survivors));
+        uint64_t value = 0;
+        for (int b = 0; b < bits; ++b) value |= ((counter[b] >> s) & 1) << b;
+        hits.push_back({first + s, static_cast<int>(value - preload)});
+        survivors &= survivors - 1;
+    }
+}
+
+void scanScalar(const Planes& planes, const std::vector<uint8_t>& planeOf, int bits, uint64_t preload,
+                size_t windows, std::vector<HammingMatcher::Hit>& hits) {
+    const size_t m = planeOf.size();
+    uint64_t counter[MAX_COUNTER_BITS];
+    for (size_t first = 0; first < windows; first += 64) {
+        for (int b = 0; b < bits; ++b) counter[b] = (preload >> b) & 1 ? ~uint64_t{0} : 0;
+        uint64_t overflow = 0;
+        for (size_t j = 0; j < m && overflow != ~uint64_t{0}; ++j) {
+            // Ripple a 1 into every start whose offset j mismatches
+            uint64_t carry = ~extract(planes.plane(planeOf[j]), first + j);
+            for (int b = 0; b < bits && carry; ++b) {
+                const uint64_t next = counter[b] & carry;
+                counter[b] ^= carry;
+                carry = next;
+            }
+            overflow |= carry;
+        }
+        collect(counter, bits, overflow, preload, first, windows, hits);
+    }
+}
+
+#ifdef BIO_HAMMING_X86
+
+__attribute__((target("avx2")))
+void buildPlanesAVX2(const char* text, size_t length, const std::vector<uint8_t>& letters, Planes& planes) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        for (size_t p = 0; p < letters.size(); ++p) {
+            const __m256i eq = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(static_cast<char>(letters[p])));
+            const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+            std::memcpy(reinterpret_cast<char*>(planes.bits.data() + p * planes.words) + i / 8, &mask, 4);
+        }
+    }
+    for (; i < length; ++i) {
+        for (size_t p = 0; p < letters.size(); ++p) {
+            if (static_cast<uint8_t>(text[i]) == letters[p]) {
+                planes.bits[p * planes.words + i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+    }
+}
+
+// Four 64-start groups per step; lane l holds starts first + 64l .. + 63
+__attribute__((target("avx2")))
+void scanAVX2(const Planes& planes, const std::vector<uint8_t>& planeOf, int bits, uint64_t preload,
+              size_t windows, std::vector<HammingMatcher::Hit>& hits) {
+    const size_t m = planeOf.size();
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    __m256i counter[MAX_COUNTER_BITS];
+    alignas(32) uint64_t lanes[MAX_COUNTER_BITS][4];
+    alignas(32) uint64_t overflowLanes[4];
+    uint64_t group[MAX_COUNTER_BITS];
+
+    for (size_t first = 0; first < windows; first += 256) {
+        for (int b = 0; b < bits; ++b) counter[b] = (preload >> b) & 1 ? ones : _mm256_setzero_si256();
+        __m256i overflow = _mm256_setzero_si256();
+        for (size_t j = 0; j < m; ++j) {
+            const size_t o = first + j;
+            const uint64_t* plane = planes.plane(planeOf[j]) + o / 64;
+            const __m128i right = _mm_cvtsi32_si128(static_cast<int>(o % 64));
+            const __m128i left = _mm_cvtsi32_si128(static_cast<int>(64 - o % 64));
+            // Shifts of 64 give zero, so no special case for aligned offsets
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(plane));
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(plane + 1));
+            const __m256i matches = _mm256_or_si256(_mm256_srl_epi64(low, right), _mm256_sll_epi64(high, left));
+            __m256i carry = _mm256_xor_si256(matches, ones);
+            for (int b = 0; b < bits; ++b) {
+                const __m256i next = _mm256_and_si256(counter[b], carry);
+                counter[b] = _mm256_xor_si256(counter[b], carry);
+                carry = next;
+            }
+            overflow = _mm256_or_si256(overflow, carry);
+            if (_mm256_testc_si256(overflow, ones)) break;
+        }
+        for (int b = 0; b < bits; ++b) _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[b]), counter[b]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(overflowLanes), overflow);
+        for (size_t l = 0; l < 4 && first + 64 * l < windows; ++l) {
+            if (overflowLanes[l] == ~uint64_t{0}) continue;
+            for (int b = 0; b < bits; ++b) group[b] = lanes[b][l];
+            collect(group, bits, overflowLanes[l], preload, first + 64 * l, windows, hits);
+        }
+    }
+}
+
+#endif // BIO_HAMMING_X86
+
+} // namespace
+
+HammingMatcher::HammingMatcher(const std::string& pattern, int maxMismatches)
+    : pattern_(pattern), maxMismatches_(maxMismatches), backend_(detectBackend()), counterBits_(1) {
+    if (pattern_.empty()) {
+        throw std::invalid_argument("HammingMatcher requires a non-empty pattern");
+    }
+    // Counters must hold k + 1 so that carrying out means "more than k"
+    while (counterBits_ < MAX_COUNTER_BITS && (uint64_t{1} << counterBits_) < static_cast<uint64_t>(std::max(maxMismatches_, 0)) + 1) {
+        ++counterBits_;
+    }
+
+    std::vector<uint16_t> index(256, NO_PLANE);
+    for (char c : pattern_) {
+        auto letter = static_cast<uint8_t>(c);
+        if (index[letter] == NO_PLANE) {
+            index[letter] = static_cast<uint16_t>(letters_.size());
+            letters_.push_back(letter);
+        }
+        planeOf_.push_back(static_cast<uint8_t>(index[letter]));
+    }
+}
+
+HammingMatcher::Backend HammingMatcher::detectBackend() {
+#ifdef BIO_HAMMING_X86
+    static const Backend detected = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? Backend::AVX2 : Backend::SCALAR;
+    }();
+    return detected;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+void HammingMatcher::setBackend(Backend backend) {
+    backend_ = std::min(backend, detectBackend());
+}
+
+std::vector<HammingMatcher::Hit> HammingMatcher::findAll(const char* text, size_t length) const {
+    std::vector<Hit> hits;
+    const size_t m = pattern_.size();
+    if (maxMismatches_ < 0 || length < m) return hits;
+    if (static_cast<size_t>(maxMismatches_) >= m) {
+        // Every window qualifies; nothing to prune
+        for (size_t start = 0; start + m <= length; ++start) {
+            int mismatches = 0;
+            for (size_t j = 0; j < m; ++j) mismatches += text[start + j] != pattern_[j];
+            hits.push_back({start, mismatches});
+        }
+        return hits;
+    }
+
+    const size_t windows = length - m + 1;
+    const uint64_t preload = (uint64_t{1} << counterBits_) - (static_cast<uint64_t>(maxMismatches_) + 1);
+    Planes planes;
+    planes.words = length / 64 + 6;
+    planes.bits.assign(letters_.size() * planes.words, 0);
+
+#ifdef BIO_HAMMING_X86
+    if (backend_ == Backend::AVX2) {
+        buildPlanesAVX2(text, length, letters_, planes);
+        scanAVX2(planes, planeOf_, counterBits_, preload, windows, hits);
+        return hits;
+    }
+#endif
+    uint16_t planeIndex[256];
+    std::fill(std::begin(planeIndex), std::end(planeIndex), NO_PLANE);
+    for (size_t p = 0; p < letters_.size(); ++p) planeIndex[letters_[p]] = static_cast<uint16_t>(p);
+    for (size_t i = 0; i < length; ++i) {
+        const uint16_t p = planeIndex[static_cast<uint8_t>(text[i])];
+        if (p != NO_PLANE) planes.bits[p * planes.words + i / 64] |= uint64_t{1} << (i % 64);
+    }
+    scanScalar(planes, planeOf_, counterBits_, preload, windows, hits);
+    return hits;
+}
+
+} // namespace bio
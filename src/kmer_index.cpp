@@ -0,0 +1,79 @@
+#include "bio/kmer_index.hpp"
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+namespace bio {
+
+namespace {
+
+constexpr uint8_t NOT_A_BASE = 4;
+
+const std::array<uint8_t, 256>& baseCodes() {
+    static const std::array<uint8_t, 256> codes = [] {
+        std::array<uint8_t, 256> table;
+        table.fill(NOT_A_BASE);
+        table['A'] = table['a'] = 0;
+        table['C'] = table['c'] = 1;
+        table['G'] = table['g'] = 2;
+        table['T'] = table['t'] = 3;
+        return table;
+    }();
+    return codes;
+}
+
+// Calls onKmer(bucket, start) for every k-mer made of bases only
+template <typename Callback>
+void forEachKmer(const std::string& text, int k, Callback&& onKmer) {
+    const auto& code = baseCodes();
+    const uint64_t mask = (uint64_t{1} << (2 * k)) - 1;
+    uint64_t bucket = 0;
+    size_t run = 0;  // Bases since the last non-base byte
+    for (size_t i = 0; i < text.size(); ++i) {
+        const uint8_t c = code[static_cast<unsigned char>(text[i])];
+        if (c == NOT_A_BASE) {
+            run = 0;
+            continue;
+        }
+        bucket = ((bucket << 2) | c) & mask;
+        if (++run >= static_cast<size_t>(k)) onKmer(bucket, i + 1 - k);
+    }
+}
+
+} // namespace
+
+KmerIndex::KmerIndex(const std::string& reference) : KmerIndex(reference, DEFAULT_K) {}
+
+KmerIndex::KmerIndex(const std::string& reference, int k) : k_(k), referenceLength_(reference.size()) {
+    if (k < 1 || k > MAX_K) {
+        throw std::invalid_argument("k-mer length must be between 1 and " + std::to_string(MAX_K));
+    }
+    if (reference.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Reference too long for a 32-bit k-mer index");
+    }
+
+    // Count, prefix-sum, then place; positions come out ascending per bucket
+    const size_t buckets = size_t{1} << (2 * k);
+    bucketStart_.assign(buckets + 1, 0);
+    forEachKmer(reference, k, [&](uint64_t bucket, size_t) { ++bucketStart_[bucket + 1]; });
+    for (size_t b = 0; b < buckets; ++b) bucketStart_[b + 1] += bucketStart_[b];
+    positions_.resize(bucketStart_[buckets]);
+    std::vector<uint32_t> next(bucketStart_.begin(), bucketStart_.end() - 1);
+    forEachKmer(reference, k, [&](uint64_t bucket, size_t start) {
+        positions_[next[bucket]++] = static_cast<uint32_t>(start);
+    });
+}
+
+KmerIndex::Range KmerIndex::lookup(const char* kmer) const {
+    const auto& code = baseCodes();
+    uint64_t bucket = 0;
+    for (int i = 0; i < k_; ++i) {
+        const uint8_t c = code[static_cast<unsigned char>(kmer[i])];
+        if (c == NOT_A_BASE) return {nullptr, nullptr};
+        bucket = (bucket << 2) | c;
+    }
+    const uint32_t* base = positions_.data();
+    return {base + bucketStart_[bucket], base + bucketStart_[bucket + 1]};
+}
+
+} // namespace bio
@@ -0,0 +1,287 @@
+#include "automata/lazy_dfa.hpp"
+
+namespace automata {
+
+namespace {
+
+constexpr uint32_t DEAD = 0;  // The empty set is always cached first
+
+// Rough per-state cost of a cache entry beyond its set and table row
+constexpr size_t STATE_OVERHEAD = 64;
+
+} // namespace
+
+LazyDFA::LazyDFA(const NFA& nfa) : LazyDFA(nfa, Options()) {}
+
+LazyDFA::LazyDFA(const NFA& nfa, const Options& options)
+    : options_(options)
+    , classes_(ByteClasses::fromNFA(nfa))
+    , columns_(classes_.getClassCount())
+{
+    // Dense renumbering of the NFA states
+    std::map<StateId, uint32_t> dense;
+    for (const auto& [id, state] : nfa.getStates()) {
+        uint32_t next = static_cast<uint32_t>(dense.size());
+        dense[id] = next;
+    }
+    const size_t n = dense.size();
+
+    // Build the forward program and its mirror image in one pass
+    auto build = [&](Program& program, bool reversed) {
+        std::vector<std::vector<uint32_t>> epsilon(n);
+        std::vector<std::vector<std::pair<uint8_t, uint32_t>>> edges(n);
+        for (const auto& t : nfa.getTransitions()) {
+            uint32_t from = dense.at(t.getFrom());
+            uint32_t to = dense.at(t.getTo());
+            if (reversed) std::swap(from, to);
+            if (t.isEpsilon()) {
+                epsilon[from].push_back(to);
+            } else if (t.isClass()) {
+                // One edge per distinct byte class the label covers
+                std::vector<bool> added(columns_, false);
+                for (Symbol s : t.getSymbols().members()) {
+                    uint8_t column = classes_.get(s);
+                    if (!added[column]) {
+                        added[column] = true;
+                        edges[from].emplace_back(column, to);
+                    }
+                }
+            } else {
+                edges[from].emplace_back(classes_.get(t.getSymbol()), to);
+            }
+        }
+
+        program.epsilonStart.assign(1, 0);
+        program.edgeStart.assign(1, 0);
+        for (size_t q = 0; q < n; ++q) {
+            program.epsilon.insert(program.epsilon.end(), epsilon[q].begin(), epsilon[q].end());
+            program.edges.insert(program.edges.end(), edges[q].begin(), edges[q].end());
+            program.epsilonStart.push_back(static_cast<uint32_t>(program.epsilon.size()));
+            program.edgeStart.push_back(static_cast<uint32_t>(program.edges.size()));
+        }
+
+        program.accepting.assign(n, false);
+        auto start = dense.find(nfa.getStartState());
+        if (!reversed) {
+            for (StateId s : nfa.getAcceptingStates()) program.accepting[dense.at(s)] = true;
+            if (start != dense.end()) program.initial.push_back(start->second);
+        } else {
+            if (start != dense.end()) program.accepting[start->second] = true;
+            for (StateId s : nfa.getAcceptingStates()) program.initial.push_back(dense.at(s));
+        }
+    };
+    build(forward_, false);
+    build(reverse_, true);
+
+    initCache(anchored_, forward_, false);
+    initCache(unanchored_, forward_, true);
+    initCache(reverseAnchored_, reverse_, false);
+    initCache(reverseUnanchored_, reverse_, true);
+}
+
+void LazyDFA::initCache(Cache& cache, const Program& program, bool restart) {
+    cache.program = &program;
+    cache.restart = false;
+    cache.mark.assign(program.size(), 0);
+
+    // Closure of the initial states: successors() of the empty set with
+    // restart on adds exactly those
+    cache.restart = true;
+    successors(cache, {}, 0, cache.start);
+    cache.restart = restart;
+    flush(cache);
+}
+
+void LazyDFA::successors(Cache& cache, const std::vector<uint32_t>& from, uint8_t column,
+                         std::vector<uint32_t>& out) {
+    const Program& program = *cache.program;
+    if (++cache.generation == 0) {
+        std::fill(cache.mark.begin(), cache.mark.end(), 0);
+        cache.generation = 1;
+    }
+    const uint32_t gen = cache.generation;
+
+    out.clear();
+    auto push = [&](uint32_t q) {
+        if (cache.mark[q] != gen) {
+            cache.mark[q] = gen;
+            out.push_back(q);
+        }
+    };
+    for (uint32_t q : from) {
+        for (uint32_t e = program.edgeStart[q]; e < program.edgeStart[q + 1]; ++e) {
+            if (program.edges[e].first == column) push(program.edges[e].second);
+        }
+    }
+    if (cache.restart) {
+        for (uint32_t q : program.initial) push(q);
+    }
+
+    // Epsilon closure, using out itself as the work list
+    for (size_t i = 0; i < out.size(); ++i) {
+        uint32_t q = out[i];
+        for (uint32_t e = program.epsilonStart[q]; e < program.epsilonStart[q + 1]; ++e) {
+            push(program.epsilon[e]);
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+LazyDFA::Index LazyDFA::insert(Cache& cache, const std::vector<uint32_t>& set) {
+    std::string key(reinterpret_cast<const char*>(set.data()), set.size() * sizeof(uint32_t));
+    auto it = cache.index.find(key);
+    if (it != cache.index.end()) return it->second;
+
+    // Set is stored twice (vector and key) next to one table row
+    size_t cost = 2 * key.size() + columns_ * sizeof(Index) + STATE_OVERHEAD;
+    if (!cache.sets.empty() && cache.memory + cost > options_.maxCacheBytes) return UNKNOWN;
+
+    Index id = static_cast<Index>(cache.sets.size());
+    cache.sets.push_back(set);
+    cache.accepting.push_back(isAccepting(cache, set));
+    cache.table.resize(cache.table.size() + columns_, UNKNOWN);
+    cache.index.emplace(std::move(key), id);
+    cache.memory += cost;
+    ++stats_.statesBuilt;
+    return id;
+}
+
+void LazyDFA::flush(Cache& cache) {
+    cache.sets.clear();
+    cache.accepting.clear();
+    cache.table.clear();
+    cache.index.clear();
+    cache.memory = 0;
+    insert(cache, {});
+}
+
+bool LazyDFA::isAccepting(const Cache& cache, const std::vector<uint32_t>& set) const {
+    for (uint32_t q : set) {
+        if (cache.program->accepting[q]) return true;
+    }
+    return false;
+}
+
+size_t LazyDFA::getCacheMemoryUsage() const {
+    return anchored_.memory + unanchored_.memory + reverseAnchored_.memory + reverseUnanchored_.memory;
+}
+
+template <typename Visit>
+void LazyDFA::scan(Cache& cache, const unsigned char* data, size_t begin, size_t end, bool backward, Visit visit) {
+    size_t offset = backward ? end : begin;
+    const size_t stop = backward ? begin : end;
+    size_t flushes = 0;
+
+    // `current` is only used once the scan has fallen back to NFA simulation
+    std::vector<uint32_t> current;
+    std::vector<uint32_t> next;
+    bool simulating = false;
+    Index state = insert(cache, cache.start);
+    if (state == UNKNOWN) {
+        // A full cache left over from earlier scans: flush it like the loop does
+        flush(cache);
+        ++stats_.cacheFlushes;
+        if (++flushes <= options_.maxFlushes) state = insert(cache, cache.start);
+    }
+    if (state == UNKNOWN) {
+        simulating = true;
+        current = cache.start;
+        ++stats_.nfaFallbacks;
+    }
+
+    bool accepting = simulating ? isAccepting(cache, current) : cache.accepting[state];
+    if (accepting && !visit(offset)) return;
+
+    while (offset != stop) {
+        unsigned char byte = backward ? data[offset - 1] : data[offset];
+        offset = backward ? offset - 1 : offset + 1;
+        uint8_t column = classes_.get(static_cast<Symbol>(byte));
+
+        if (!simulating) {
+            if (state == DEAD) return;
+            Index target = cache.table[static_cast<size_t>(state) * columns_ + column];
+            if (target == UNKNOWN) {
+                successors(cache, cache.sets[state], column, next);
+                target = insert(cache, next);
+                if (target != UNKNOWN) {
+                    cache.table[static_cast<size_t>(state) * columns_ + column] = target;
+                } else {
+                    // Out of room: start over with an empty cache, or give up
+                    // on caching for the rest of this scan
+                    flush(cache);
+                    ++stats_.cacheFlushes;
+                    if (++flushes <= options_.maxFlushes) target = insert(cache, next);
+                    if (target == UNKNOWN) {
+                        simulating = true;
+                        current.swap(next);
+                        ++stats_.nfaFallbacks;
+                    }
+                }
+            }
+            if (!simulating) {
+                state = target;
+                if (cache.accepting[state] && !visit(offset)) return;
+                continue;
+            }
+        } else {
+            successors(cache, current, column, next);
+            current.swap(next);
+        }
+
+        if (current.empty()) return;
+        if (isAccepting(cache, current) && !visit(offset)) return;
+    }
+}
+
+bool LazyDFA::accepts(const std::string& input) {
+    const auto* data = reinterpret_cast<const unsigned char*>(input.data());
+    bool accepted = false;
+    scan(anchored_, data, 0, input.size(), false, [&](size_t offset) {
+        accepted = offset == input.size();
+        return true;
+    });
+    return accepted;
+}
+
+std::vector<LazyDFA::Match> LazyDFA::findAll(const std::string& text, MatchKind kind) {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t length = text.size();
+    std::vector<Match> matches;
+
+    if (kind == MatchKind::ALL_OVERLAPPING) {
+        // Σ*L reports every match end; reverse(L) from each end reports its starts
+        scan(unanchored_, data, 0, length, false, [&](size_t end) {
+            scan(reverseAnchored_, data, 0, end, true, [&](size_t start) {
+                matches.emplace_back(start, end);
+                return true;
+            });
+            return true;
+        });
+        std::sort(matches.begin(), matches.end());
+        return matches;
+    }
+
+    // Σ*·reverse(L) scanned backwards reports every match start (descending)
+    std::vector<size_t> starts;
+    scan(reverseUnanchored_, data, 0, length, true, [&](size_t start) {
+        starts.push_back(start);
+        return true;
+    });
+    std::reverse(starts.begin(), starts.end());
+
+    const bool longest = kind == MatchKind::LEFTMOST_LONGEST;
+    size_t pos = 0;
+    for (size_t start : starts) {
+        if (start < pos) continue;
+        size_t end = start;
+        scan(anchored_, data, start, length, false, [&](size_t offset) {
+            end = offset;
+            return longest;
+        });
+        matches.emplace_back(start, end);
+        pos = end > start ? end : start + 1;
+    }
+    return matches;
+}
+
+} // namespace automata
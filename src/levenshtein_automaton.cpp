@@ -0,0 +1,128 @@
+#include "bio/levenshtein_automaton.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+
+namespace bio {
+
+namespace {
+
+// NFA position relative to the base: pattern offset and errors so far
+using Position = std::pair<int, int>;
+using PositionSet = std::vector<Position>;
+
+// (o, e) subsumes (o2, e2) when everything reachable from (o2, e2) is also
+// reachable from (o, e) at no greater cost
+bool subsumes(const Position& a, const Position& b) {
+    return a.second < b.second && std::abs(a.first - b.first) <= b.second - a.second;
+}
+
+// Drop subsumed positions and rebase on the smallest offset
+int normalize(PositionSet& positions) {
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    PositionSet reduced;
+    for (const auto& p : positions) {
+        bool covered = false;
+        for (const auto& q : positions) {
+            if (subsumes(q, p)) {
+                covered = true;
+                break;
+            }
+        }
+        if (!covered) reduced.push_back(p);
+    }
+    positions.swap(reduced);
+    if (positions.empty()) return 0;
+    const int base = positions.front().first;
+    for (auto& p : positions) p.first -= base;
+    return base;
+}
+
+} // namespace
+
+UniversalLevenshtein::UniversalLevenshtein(int k) : k_(k), window_(2 * k + 2) {
+    // A reduced state spans offsets 0..2k, and a position with e errors looks
+    // at most k - e letters past its offset, so 2k + 2 bits always suffice
+    const uint32_t vectors = uint32_t{1} << window_;
+    std::vector<PositionSet> states = {{}, {{0, 0}}};
+    std::map<PositionSet, State> index = {{states[0], DEAD}, {states[1], 1}};
+
+    for (State s = 0; s < states.size(); ++s) {
+        for (uint32_t vector = 0; vector < vectors; ++vector) {
+            auto matches = [vector](int offset) { return (vector >> offset) & 1; };
+            PositionSet successors;
+            for (const auto& [offset, errors] : states[s]) {
+                if (matches(offset)) successors.push_back({offset + 1, errors});
+                if (errors == k) continue;
+                successors.push_back({offset, errors + 1});      // Insertion
+                successors.push_back({offset + 1, errors + 1});  // Substitution
+                // Deletions of j pattern letters followed by a match
+                for (int j = 1; j <= k - errors; ++j) {
+                    if (matches(offset + j)) successors.push_back({offset + j + 1, errors + j});
+                }
+            }
+            const int shift = normalize(successors);
+            auto inserted = index.emplace(successors, static_cast<State>(states.size()));
+            if (inserted.second) states.push_back(successors);
+            next_.push_back(inserted.first->second);
+            shifts_.push_back(static_cast<uint8_t>(shift));
+        }
+    }
+
+    // Remaining pattern beyond the largest offset plus k can never be deleted
+    int maxOffset = 0;
+    for (const auto& positions : states) {
+        for (const auto& p : positions) maxOffset = std::max(maxOffset, p.first);
+    }
+    reach_ = static_cast<size_t>(maxOffset + k + 1);
+    distances_.assign(states.size() * reach_, static_cast<uint8_t>(k + 1));
+    for (State s = 0; s < states.size(); ++s) {
+        for (size_t remaining = 0; remaining < reach_; ++remaining) {
+            int best = k + 1;
+            for (const auto& [offset, errors] : states[s]) {
+                best = std::min(best, errors + std::max(0, static_cast<int>(remaining) - offset));
+            }
+            distances_[s * reach_ + remaining] = static_cast<uint8_t>(best);
+        }
+    }
+}
+
+const UniversalLevenshtein& UniversalLevenshtein::forDistance(int k) {
+    if (k < 0 || k > MAX_DISTANCE) {
+        throw std::invalid_argument("Universal Levenshtein automata are built for distances 0-" +
+                                    std::to_string(MAX_DISTANCE));
+    }
+    static const std::array<UniversalLevenshtein, MAX_DISTANCE + 1> automata = {
+        UniversalLevenshtein(0), UniversalLevenshtein(1), UniversalLevenshtein(2), UniversalLevenshtein(3)};
+    return automata[k];
+}
+
+LevenshteinDFA::LevenshteinDFA(const std::string& pattern, int k)
+    : automaton_(&UniversalLevenshtein::forDistance(k)), length_(pattern.size()),
+      words_((pattern.size() + UniversalLevenshtein::MAX_DISTANCE) / 64 + 2) {
+    // Mask 0 stays empty for letters that do not occur in the pattern
+    std::fill(std::begin(maskIndex_), std::end(maskIndex_), 0);
+    uint16_t letters = 0;
+    for (char c : pattern) {
+        auto& slot = maskIndex_[static_cast<unsigned char>(c)];
+        if (slot == 0) slot = ++letters;
+    }
+    masks_.assign((letters + 1) * words_, 0);
+    for (size_t i = 0; i < length_; ++i) {
+        masks_[maskIndex_[static_cast<unsigned char>(pattern[i])] * words_ + i / 64] |= uint64_t{1} << (i % 64);
+    }
+}
+
+bool LevenshteinDFA::accepts(const std::string& text) const {
+    Cursor cursor = start();
+    for (char c : text) {
+        cursor = next(cursor, c);
+        if (isDead(cursor)) return false;
+    }
+    return isAccepting(cursor);
+}
+
+} // namespace bio
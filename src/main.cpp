@@ -58,7 +58,7 @@ void printNFAVisualization(const automata::NFA& nfa, const std::string& pattern)
     // Group transitions by source state
     std::map<automata::StateId, std::vector<std::pair<std::string, automata::StateId>>> grouped;
     for (const auto& t : transitions) {
-        std::string symbol = t.isEpsilon() ? "ε" : std::string(1, t.getSymbol());
+        std::string symbol = t.getLabel();
         grouped[t.getFrom()].push_back({symbol, t.getTo()});
     }
     
@@ -191,7 +191,7 @@ void runVizDemo(const std::string& pattern) {
             if (t.isEpsilon()) {
                 std::cout << std::setw(15) << "ε (epsilon)";
             } else {
-                std::cout << std::setw(15) << t.getSymbol();
+                std::cout << std::setw(15) << t.getLabel();
             }
             std::cout << std::setw(10) << ("q" + std::to_string(t.getTo())) << "\n";
         }
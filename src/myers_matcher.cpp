@@ -0,0 +1,79 @@
+#include "bio/myers_matcher.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace bio {
+
+MyersMatcher::MyersMatcher(const std::string& pattern)
+    : length_(pattern.size()), words_((pattern.size() + 63) / 64) {
+    if (pattern.empty()) {
+        throw std::invalid_argument("MyersMatcher requires a non-empty pattern");
+    }
+    peq_.assign(256 * words_, 0);
+    peqReverse_.assign(256 * words_, 0);
+    for (size_t i = 0; i < length_; ++i) {
+        auto c = static_cast<unsigned char>(pattern[i]);
+        auto r = static_cast<unsigned char>(pattern[length_ - 1 - i]);
+        peq_[c * words_ + i / 64] |= uint64_t{1} << (i % 64);
+        peqReverse_[r * words_ + i / 64] |= uint64_t{1} << (i % 64);
+    }
+}
+
+int MyersMatcher::advance(const uint64_t* eq, uint64_t* pv, uint64_t* mv, int carryIn) const {
+    // carryIn is the horizontal delta entering the top row of block 0:
+    // 0 when matches may start anywhere, +1 for a global alignment
+    int carry = carryIn;
+    for (size_t b = 0; b < words_; ++b) {
+        const uint64_t negIn = carry < 0 ? 1 : 0;
+        const uint64_t posIn = carry > 0 ? 1 : 0;
+        uint64_t p = pv[b];
+        uint64_t m = mv[b];
+        uint64_t e = eq[b];
+
+        const uint64_t xv = e | m;
+        e |= negIn;
+        const uint64_t xh = (((e & p) + p) ^ p) | e;
+        uint64_t ph = m | ~(xh | p);
+        uint64_t mh = p & xh;
+
+        // Horizontal delta leaving this block's last row
+        const unsigned top = b + 1 == words_ ? static_cast<unsigned>((length_ - 1) % 64) : 63;
+        carry = static_cast<int>((ph >> top) & 1) - static_cast<int>((mh >> top) & 1);
+
+        ph = (ph << 1) | posIn;
+        mh = (mh << 1) | negIn;
+        pv[b] = mh | ~(xv | ph);
+        mv[b] = ph & xv;
+    }
+    return carry;
+}
+
+std::vector<MyersMatcher::End> MyersMatcher::findEnds(const char* text, size_t length, int k) const {
+    std::vector<End> ends;
+    std::vector<uint64_t> pv(words_, ~uint64_t{0});
+    std::vector<uint64_t> mv(words_, 0);
+    int score = static_cast<int>(length_);
+    for (size_t j = 0; j < length; ++j) {
+        const uint64_t* eq = peq_.data() + static_cast<unsigned char>(text[j]) * words_;
+        score += advance(eq, pv.data(), mv.data(), 0);
+        if (score <= k) ends.push_back({j + 1, score});
+    }
+    return ends;
+}
+
+void MyersMatcher::distancesEndingAt(const char* text, size_t end, size_t maxLength,
+                                     std::vector<int>& distances) const {
+    const size_t limit = std::min(maxLength, end);
+    distances.assign(limit + 1, 0);
+    std::vector<uint64_t> pv(words_, ~uint64_t{0});
+    std::vector<uint64_t> mv(words_, 0);
+    int score = static_cast<int>(length_);
+    distances[0] = score;
+    for (size_t len = 1; len <= limit; ++len) {
+        const uint64_t* eq = peqReverse_.data() + static_cast<unsigned char>(text[end - len]) * words_;
+        score += advance(eq, pv.data(), mv.data(), 1);
+        distances[len] = score;
+    }
+}
+
+} // namespace bio
@@ -1,4 +1,5 @@
 #include "automata/nfa.hpp"
+#include "automata/frozen_nfa.hpp"
 #include "automata/json_serializer.hpp"
 
 namespace automata {
@@ -14,6 +15,7 @@ NFA::NFA(const NFA& other)
     , startState_(other.startState_)
     , acceptingStates_(other.acceptingStates_)
     , nextStateId_(other.nextStateId_)
+    , frozen_(std::atomic_load(&other.frozen_))
 {}
 
 NFA::NFA(NFA&& other) noexcept
@@ -22,6 +24,7 @@ NFA::NFA(NFA&& other) noexcept
     , startState_(other.startState_)
     , acceptingStates_(std::move(other.acceptingStates_))
     , nextStateId_(other.nextStateId_)
+    , frozen_(std::move(other.frozen_))
 {}
 
 NFA& NFA::operator=(const NFA& other) {
@@ -31,6 +34,7 @@ NFA& NFA::operator=(const NFA& other) {
         startState_ = other.startState_;
         acceptingStates_ = other.acceptingStates_;
         nextStateId_ = other.nextStateId_;
+        frozen_ = std::atomic_load(&other.frozen_);
     }
     return *this;
 }
@@ -42,6 +46,7 @@ NFA& NFA::operator=(NFA&& other) noexcept {
         startState_ = other.startState_;
         acceptingStates_ = std::move(other.acceptingStates_);
         nextStateId_ = other.nextStateId_;
+        frozen_ = std::move(other.frozen_);
     }
     return *this;
 }
@@ -55,6 +60,7 @@ StateId NFA::addState(const std::string& label, bool isAccepting) {
     if (isAccepting) {
         acceptingStates_.insert(id);
     }
+    invalidateCaches();
     return id;
 }
 
@@ -67,6 +73,7 @@ void NFA::setStartState(StateId id) {
     }
     startState_ = id;
     states_.at(id).setStart(true);
+    invalidateCaches();
 }
 
 void NFA::setAcceptingState(StateId id, bool accepting) {
@@ -79,6 +86,7 @@ void NFA::setAcceptingState(StateId id, bool accepting) {
     } else {
         acceptingStates_.erase(id);
     }
+    invalidateCaches();
 }
 
 void NFA::addTransition(StateId from, StateId to, Symbol symbol) {
@@ -89,6 +97,18 @@ void NFA::addTransition(StateId from, StateId to, Symbol symbol) {
         throw InvalidStateException(to);
     }
     transitions_.emplace_back(from, to, symbol);
+    invalidateCaches();
+}
+
+void NFA::addTransition(StateId from, StateId to, const SymbolSet& symbols) {
+    if (states_.find(from) == states_.end()) {
+        throw InvalidStateException(from);
+    }
+    if (states_.find(to) == states_.end()) {
+        throw InvalidStateException(to);
+    }
+    transitions_.emplace_back(from, to, symbols);
+    invalidateCaches();
 }
 
 void NFA::addEpsilonTransition(StateId from, StateId to) {
@@ -108,7 +128,7 @@ std::vector<Transition> NFA::getTransitionsFrom(StateId state) const {
 std::vector<Transition> NFA::getTransitionsFrom(StateId state, Symbol symbol) const {
     std::vector<Transition> result;
     for (const auto& t : transitions_) {
-        if (t.getFrom() == state && t.getSymbol() == symbol) {
+        if (t.getFrom() == state && (symbol == EPSILON ? t.isEpsilon() : t.matches(symbol))) {
             result.push_back(t);
         }
     }
@@ -157,50 +177,80 @@ std::set<StateId> NFA::move(const std::set<StateId>& states, Symbol symbol) cons
 }
 
 std::set<StateId> NFA::extendedDelta(const std::set<StateId>& states, const std::string& input) const {
-    std::set<StateId> current = epsilonClosure(states);
+    auto snapshot = getFrozen();
+    const FrozenNFA& frozen = *snapshot;
+    std::vector<FrozenNFA::Index> initial;
+    for (FrozenNFA::Index q = 0; q < frozen.getStateCount(); ++q) {
+        if (states.count(frozen.getStateId(q))) initial.push_back(q);
+    }
     
+    NFASimulator simulator(frozen);
+    simulator.reset(initial);
     for (char c : input) {
-        current = epsilonClosure(move(current, c));
+        if (!simulator.step(c)) break;
     }
     
-    return current;
+    return frozen.toStateIds(simulator.getStates());
 }
 
 bool NFA::accepts(const std::string& input) const {
     if (startState_ < 0) return false;
     
-    std::set<StateId> finalStates = extendedDelta({startState_}, input);
-    
-    for (StateId s : finalStates) {
-        if (acceptingStates_.count(s)) {
-            return true;
-        }
+    auto frozen = getFrozen();
+    NFASimulator simulator(*frozen);
+    for (char c : input) {
+        if (!simulator.step(c)) return false;
     }
-    return false;
+    return simulator.isAccepting();
+}
+
+FrozenNFA NFA::freeze() const {
+    return FrozenNFA::fromNFA(*this);
+}
+
+std::shared_ptr<const FrozenNFA> NFA::getFrozen() const {
+    // Concurrent readers may both build it; either snapshot is the same
+    auto frozen = std::atomic_load(&frozen_);
+    if (!frozen) {
+        frozen = std::make_shared<const FrozenNFA>(freeze());
+        std::atomic_store(&frozen_, frozen);
+    }
+    return frozen;
+}
+
+void NFA::invalidateCaches() {
+    frozen_.reset();
 }
 
 std::vector<NFA::ExecutionStep> NFA::traceExecution(const std::string& input) const {
     std::vector<ExecutionStep> trace;
     if (startState_ < 0) return trace;
     
-    std::set<StateId> current = {startState_};
+    auto snapshot = getFrozen();
+    const FrozenNFA& frozen = *snapshot;
+    SparseSet scratch(frozen.getStateCount());
+    std::vector<FrozenNFA::Index> current, afterMove, afterEpsilon;
+    if (!frozen.hasStartState()) return trace;
+    current.push_back(frozen.getStartState());
     
     // Initial epsilon closure
-    std::set<StateId> afterEpsilon = epsilonClosure(current);
+    afterEpsilon = current;
+    frozen.epsilonClosure(afterEpsilon, scratch);
     if (afterEpsilon != current) {
-        trace.push_back({current, EPSILON, afterEpsilon, true});
+        trace.push_back({frozen.toStateIds(current), EPSILON, frozen.toStateIds(afterEpsilon), true});
         current = afterEpsilon;
     }
     
     for (char c : input) {
-        std::set<StateId> afterMove = move(current, c);
-        trace.push_back({current, c, afterMove, false});
+        frozen.move(current, c, afterMove, scratch);
+        trace.push_back({frozen.toStateIds(current), c, frozen.toStateIds(afterMove), false});
         
-        std::set<StateId> afterEpsilonMove = epsilonClosure(afterMove);
-        if (afterEpsilonMove != afterMove) {
-            trace.push_back({afterMove, EPSILON, afterEpsilonMove, true});
+        afterEpsilon = afterMove;
+        frozen.epsilonClosure(afterEpsilon, scratch);
+        if (afterEpsilon != afterMove) {
+            trace.push_back({frozen.toStateIds(afterMove), EPSILON, frozen.toStateIds(afterEpsilon), true});
         }
-        current = afterEpsilonMove;
+        current.swap(afterEpsilon);
     }
     
     return trace;
@@ -209,7 +259,9 @@ std::vector<NFA::ExecutionStep> NFA::traceExecution(const std::string& input) co
 std::set<Symbol> NFA::getAlphabet() const {
     std::set<Symbol> alphabet;
     for (const auto& t : transitions_) {
-        if (!t.isEpsilon()) {
+        if (t.isClass()) {
+            for (Symbol s : t.getSymbols().members()) alphabet.insert(s);
+        } else if (!t.isEpsilon()) {
             alphabet.insert(t.getSymbol());
         }
     }
@@ -272,7 +324,7 @@ void NFA::renumberStates(StateId offset) {
     }
     
     for (const auto& t : transitions_) {
-        newTransitions.emplace_back(mapping[t.getFrom()], mapping[t.getTo()], t.getSymbol());
+        newTransitions.push_back(t.withEndpoints(mapping[t.getFrom()], mapping[t.getTo()]));
     }
     
     states_ = std::move(newStates);
@@ -280,6 +332,7 @@ void NFA::renumberStates(StateId offset) {
     acceptingStates_ = std::move(newAccepting);
     startState_ = mapping[startState_];
     nextStateId_ = newId;
+    invalidateCaches();
 }
 
 // Thompson's construction building blocks
@@ -360,6 +413,7 @@ NFA NFA::createConcat(NFA&& a, NFA&& b) {
     
     // Copy all states and transitions from both
     NFA result = std::move(a);
+    result.invalidateCaches();
     
     for (const auto& [id, state] : b.states_) {
         result.states_.emplace(id, State(id, "", state.isAccepting(), false));
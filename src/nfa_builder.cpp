@@ -0,0 +1,118 @@
+#include "automata/nfa_builder.hpp"
+
+namespace automata {
+
+NFABuilder::NFABuilder() : nextState_(0) {}
+
+NFABuilder::Fragment NFABuilder::finish(StateId start, StateId end, const Fragment& first) const {
+    return {start, end, first.firstState, nextState_, first.firstTransition, transitions_.size()};
+}
+
+NFABuilder::Fragment NFABuilder::empty() {
+    StateId start = newState();
+    StateId end = newState();
+    size_t firstTransition = transitions_.size();
+    transitions_.emplace_back(start, end, EPSILON);
+    return {start, end, start, nextState_, firstTransition, transitions_.size()};
+}
+
+NFABuilder::Fragment NFABuilder::single(Symbol symbol) {
+    StateId start = newState();
+    StateId end = newState();
+    size_t firstTransition = transitions_.size();
+    transitions_.emplace_back(start, end, symbol);
+    return {start, end, start, nextState_, firstTransition, transitions_.size()};
+}
+
+NFABuilder::Fragment NFABuilder::symbols(const SymbolSet& set) {
+    StateId start = newState();
+    StateId end = newState();
+    size_t firstTransition = transitions_.size();
+    transitions_.emplace_back(start, end, set);
+    return {start, end, start, nextState_, firstTransition, transitions_.size()};
+}
+
+NFABuilder::Fragment NFABuilder::alternate(const std::vector<Fragment>& alternatives) {
+    if (alternatives.empty()) return empty();
+    if (alternatives.size() == 1) return alternatives.front();
+
+    StateId start = newState();
+    StateId end = newState();
+    for (const auto& f : alternatives) {
+        transitions_.emplace_back(start, f.start, EPSILON);
+        transitions_.emplace_back(f.end, end, EPSILON);
+    }
+    return finish(start, end, alternatives.front());
+}
+
+NFABuilder::Fragment NFABuilder::concat(const Fragment& a, const Fragment& b) {
+    transitions_.emplace_back(a.end, b.start, EPSILON);
+    return finish(a.start, b.end, a);
+}
+
+NFABuilder::Fragment NFABuilder::star(const Fragment& a) {
+    StateId start = newState();
+    StateId end = newState();
+    transitions_.emplace_back(start, a.start, EPSILON);
+    transitions_.emplace_back(start, end, EPSILON);
+    transitions_.emplace_back(a.end, a.start, EPSILON);
+    transitions_.emplace_back(a.end, end, EPSILON);
+    return finish(start, end, a);
+}
+
+NFABuilder::Fragment NFABuilder::plus(const Fragment& a) {
+    // Like star without the skip edge, so no copy of a is needed
+    StateId start = newState();
+    StateId end = newState();
+    transitions_.emplace_back(start, a.start, EPSILON);
+    transitions_.emplace_back(a.end, a.start, EPSILON);
+    transitions_.emplace_back(a.end, end, EPSILON);
+    return finish(start, end, a);
+}
+
+NFABuilder::Fragment NFABuilder::optional(const Fragment& a) {
+    StateId start = newState();
+    StateId end = newState();
+    transitions_.emplace_back(start, a.start, EPSILON);
+    transitions_.emplace_back(start, end, EPSILON);
+    transitions_.emplace_back(a.end, end, EPSILON);
+    return finish(start, end, a);
+}
+
+NFABuilder::Fragment NFABuilder::copy(const Fragment& fragment) {
+    const StateId offset = nextState_ - fragment.firstState;
+    nextState_ += fragment.stateEnd - fragment.firstState;
+
+    const size_t firstTransition = transitions_.size();
+    transitions_.reserve(firstTransition + (fragment.transitionEnd - fragment.firstTransition));
+    for (size_t i = fragment.firstTransition; i < fragment.transitionEnd; ++i) {
+        const Transition t = transitions_[i];
+        transitions_.push_back(t.withEndpoints(t.getFrom() + offset, t.getTo() + offset));
+    }
+    return {fragment.start + offset, fragment.end + offset, fragment.firstState + offset, nextState_,
+            firstTransition, transitions_.size()};
+}
+
+NFA NFABuilder::build(const Fragment& fragment) const {
+    NFA nfa;
+    const StateId base = fragment.firstState;
+    const StateId count = fragment.stateEnd - fragment.firstState;
+    const StateId start = fragment.start - base;
+    const StateId end = fragment.end - base;
+
+    // Ids are increasing, so every insertion goes at the back of the map
+    for (StateId id = 0; id < count; ++id) {
+        nfa.states_.emplace_hint(nfa.states_.end(), id, State(id, "", id == end, id == start));
+    }
+    nfa.transitions_.reserve(fragment.transitionEnd - fragment.firstTransition);
+    for (size_t i = fragment.firstTransition; i < fragment.transitionEnd; ++i) {
+        const Transition& t = transitions_[i];
+        nfa.transitions_.push_back(t.withEndpoints(t.getFrom() - base, t.getTo() - base));
+    }
+    nfa.startState_ = start;
+    nfa.acceptingStates_.insert(end);
+    nfa.nextStateId_ = count;
+    return nfa;
+}
+
+} // namespace automata
@@ -0,0 +1,177 @@
+#include "automata/parallel_scan.hpp"
+#include <thread>
+
+namespace automata {
+
+namespace {
+
+using Index = CompiledDFA::Index;
+
+// Run fn(0..count-1) with one thread per index
+template <typename F>
+void parallelFor(size_t count, F&& fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i = 1; i < count; ++i) workers.emplace_back([&fn, i] { fn(i); });
+    if (count > 0) fn(0);
+    for (auto& w : workers) w.join();
+}
+
+// Advance every state in `states` over data, merging lanes that reach the
+// same state so converging DFAs quickly drop to a single lane
+void runLanes(const CompiledDFA& dfa, std::vector<Index>& states, const unsigned char* data, size_t length) {
+    std::vector<Index> lanes(states.begin(), states.end());
+    std::vector<size_t> laneOf(states.size());
+    for (size_t j = 0; j < laneOf.size(); ++j) laneOf[j] = j;
+    std::vector<int> slot(dfa.getStateCount(), -1);
+
+    auto compact = [&] {
+        std::vector<Index> merged;
+        std::vector<size_t> remap(lanes.size());
+        for (size_t l = 0; l < lanes.size(); ++l) {
+            if (slot[lanes[l]] < 0) {
+                slot[lanes[l]] = static_cast<int>(merged.size());
+                merged.push_back(lanes[l]);
+            }
+            remap[l] = static_cast<size_t>(slot[lanes[l]]);
+        }
+        for (Index s : merged) slot[s] = -1;
+        for (auto& l : laneOf) l = remap[l];
+        lanes.swap(merged);
+    };
+
+    constexpr size_t BLOCK = 256;
+    compact();
+    size_t pos = 0;
+    while (pos < length) {
+        if (lanes.size() == 1) {
+            lanes[0] = dfa.run(lanes[0], reinterpret_cast<const char*>(data + pos), length - pos);
+            break;
+        }
+        size_t end = std::min(length, pos + BLOCK);
+        for (size_t i = pos; i < end; ++i) {
+            for (auto& s : lanes) s = dfa.next(s, data[i]);
+        }
+        pos = end;
+        compact();
+    }
+    for (size_t j = 0; j < states.size(); ++j) states[j] = lanes[laneOf[j]];
+}
+
+} // namespace
+
+ParallelScanner::ParallelScanner(const DFA& dfa) : ParallelScanner(dfa, Options()) {}
+
+ParallelScanner::ParallelScanner(const DFA& dfa, const Options& options)
+    : options_(options)
+    , anchored_(CompiledDFA::fromDFA(dfa))
+{
+    if (options_.threads == 0) {
+        options_.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    options_.minChunkSize = std::max<size_t>(options_.minChunkSize, 1);
+}
+
+std::shared_ptr<const DFASearcher> ParallelScanner::getSearcher() const {
+    auto searcher = std::atomic_load(&searcher_);
+    if (!searcher) {
+        // Racing threads may both build it; either result is equivalent
+        searcher = std::make_shared<const DFASearcher>(anchored_, MatchKind::ALL_OVERLAPPING);
+        std::atomic_store(&searcher_, searcher);
+    }
+    return searcher;
+}
+
+std::vector<ParallelScanner::Chunk> ParallelScanner::split(size_t length) const {
+    size_t count = std::max<size_t>(1, std::min(options_.threads, length / options_.minChunkSize));
+    std::vector<Chunk> chunks(count);
+    for (size_t i = 0; i < count; ++i) {
+        chunks[i].begin = length * i / count;
+        chunks[i].end = length * (i + 1) / count;
+    }
+    return chunks;
+}
+
+void ParallelScanner::mapChunk(const CompiledDFA& dfa, const unsigned char* text, Chunk& chunk) const {
+    std::vector<Index>& entries = chunk.entries;
+    if (chunk.begin == 0) {
+        entries.assign(1, dfa.getStartState());
+    } else {
+        entries.clear();
+        for (Index s = 1; s < dfa.getStateCount(); ++s) entries.push_back(s);
+        if (options_.speculate && options_.lookback > 0) {
+            // Whatever state the scan is in before the window, it ends up in this set
+            size_t window = std::min(options_.lookback, chunk.begin);
+            runLanes(dfa, entries, text + chunk.begin - window, window);
+            std::sort(entries.begin(), entries.end());
+            entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+        }
+    }
+    chunk.exits = entries;
+    runLanes(dfa, chunk.exits, text + chunk.begin, chunk.end - chunk.begin);
+}
+
+std::vector<CompiledDFA::Index> ParallelScanner::entryStates(const CompiledDFA& dfa, const unsigned char* text,
+                                                            std::vector<Chunk>& chunks) const {
+    parallelFor(chunks.size(), [&](size_t i) { mapChunk(dfa, text, chunks[i]); });
+
+    // Prefix composition of the chunk maps; the last entry is the final state
+    std::vector<Index> states(chunks.size() + 1);
+    states[0] = dfa.getStartState();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& entries = chunks[i].entries;
+        auto it = std::lower_bound(entries.begin(), entries.end(), states[i]);
+        states[i + 1] = (it != entries.end() && *it == states[i])
+            ? chunks[i].exits[it - entries.begin()]
+            : CompiledDFA::DEAD;
+    }
+    return states;
+}
+
+bool ParallelScanner::accepts(const std::string& text) const {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    auto chunks = split(text.size());
+    return anchored_.isAccepting(entryStates(anchored_, data, chunks).back());
+}
+
+std::vector<ParallelScanner::Match> ParallelScanner::findAllMatches(const std::string& text) const {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    const auto searcher = getSearcher();
+    const CompiledDFA& forward = searcher->getForward();
+    const CompiledDFA& reverse = searcher->getReverse();
+    auto chunks = split(text.size());
+    auto states = entryStates(forward, data, chunks);
+
+    // Rescan each chunk from its true entry state; starts are recovered by
+    // walking the reverse DFA back from each end, possibly into earlier chunks
+    std::vector<std::vector<Match>> found(chunks.size());
+    parallelFor(chunks.size(), [&](size_t i) {
+        auto& out = found[i];
+        auto collectStarts = [&](size_t end) {
+            Index state = reverse.getStartState();
+            if (reverse.isAccepting(state)) out.emplace_back(end, end);
+            for (size_t p = end; p > 0; --p) {
+                state = reverse.next(state, data[p - 1]);
+                if (state == CompiledDFA::DEAD) break;
+                if (reverse.isAccepting(state)) out.emplace_back(p - 1, end);
+            }
+        };
+        Index state = states[i];
+        if (i == 0 && forward.isAccepting(state)) collectStarts(0);
+        for (size_t j = chunks[i].begin; j < chunks[i].end; ++j) {
+            state = forward.next(state, data[j]);
+            if (forward.isAccepting(state)) collectStarts(j + 1);
+        }
+        std::sort(out.begin(), out.end());
+    });
+
+    std::vector<Match> matches;
+    for (auto& part : found) {
+        size_t middle = matches.size();
+        matches.insert(matches.end(), part.begin(), part.end());
+        std::inplace_merge(matches.begin(), matches.begin() + middle, matches.end());
+    }
+    return matches;
+}
+
+} // namespace automata
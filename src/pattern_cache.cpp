@@ -0,0 +1,80 @@
+#include "api/pattern_cache.hpp"
+
+namespace api {
+
+PatternCache::PatternCache(size_t capacity, Compiler compiler)
+    : capacity_(capacity), compiler_(std::move(compiler)), hits_(0), misses_(0) {}
+
+std::string PatternCache::encode(const PatternKey& key) {
+    // Length-prefixed fields, so no pattern can collide with another key
+    return std::to_string(key.flags) + ':' + std::to_string(key.maxDistance) + ':' +
+           std::to_string(key.alphabet.size()) + ':' + key.alphabet + key.pattern;
+}
+
+std::shared_ptr<const CompiledPattern> PatternCache::get(const PatternKey& key) {
+    const std::string encoded = encode(key);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(encoded);
+        if (it != index_.end()) {
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->second;
+        }
+        ++misses_;
+    }
+
+    std::shared_ptr<const CompiledPattern> compiled = compiler_(key);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return insert(encoded, std::move(compiled));
+}
+
+void PatternCache::warmUp(const PatternKey& key) {
+    const std::string encoded = encode(key);
+    std::shared_ptr<const CompiledPattern> compiled = compiler_(key);
+    std::lock_guard<std::mutex> lock(mutex_);
+    insert(encoded, std::move(compiled));
+}
+
+std::shared_ptr<const CompiledPattern> PatternCache::insert(const std::string& encoded,
+                                                            std::shared_ptr<const CompiledPattern> compiled) {
+    if (capacity_ == 0) return compiled;
+
+    auto it = index_.find(encoded);
+    if (it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+    }
+    entries_.emplace_front(encoded, std::move(compiled));
+    index_.emplace(encoded, entries_.begin());
+    if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    return entries_.front().second;
+}
+
+uint64_t PatternCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t PatternCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+size_t PatternCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void PatternCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+} // namespace api
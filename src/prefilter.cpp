@@ -0,0 +1,341 @@
+#include "automata/prefilter.hpp"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AUTOMATA_PREFILTER_X86
+#include <immintrin.h>
+#endif
+
+namespace automata {
+
+namespace {
+
+using Node = std::shared_ptr<RegexParser::ASTNode>;
+using NodeType = RegexParser::NodeType;
+
+// Literal facts about the strings a subexpression matches
+struct LiteralInfo {
+    bool exact = false;    // Matches exactly one string, `literal`
+    std::string literal;
+    std::string prefix;    // Every match starts with this
+    std::string suffix;    // Every match ends with this
+    std::string required;  // Every match contains this
+
+    static LiteralInfo exactly(const std::string& s) {
+        LiteralInfo info;
+        info.exact = true;
+        info.literal = info.prefix = info.suffix = info.required = s;
+        return info;
+    }
+};
+
+void keepLonger(std::string& best, const std::string& candidate) {
+    if (candidate.size() > best.size()) best = candidate;
+}
+
+std::string repeatString(const std::string& s, int times) {
+    std::string result;
+    result.reserve(s.size() * static_cast<size_t>(times));
+    for (int i = 0; i < times; ++i) result += s;
+    return result;
+}
+
+LiteralInfo analyze(const Node& node) {
+    if (!node) return LiteralInfo::exactly("");
+
+    switch (node->type) {
+        case NodeType::EPSILON:
+        case NodeType::START_ANCHOR:
+        case NodeType::END_ANCHOR:
+            return LiteralInfo::exactly("");
+
+        case NodeType::CHAR:
+            return LiteralInfo::exactly(std::string(1, node->value));
+
+        case NodeType::CHAR_CLASS:
+            if (node->charClass.size() == 1) return LiteralInfo::exactly(std::string(1, *node->charClass.begin()));
+            return {};
+
+        case NodeType::GROUP:
+            return analyze(node->children[0]);
+
+        case NodeType::CONCAT: {
+            // `run` is the literal text ending at the current child; it is
+            // extended by exact children and restarted after inexact ones
+            LiteralInfo result;
+            result.exact = true;
+            std::string run;
+            bool inPrefix = true;
+            for (const auto& child : node->children) {
+                LiteralInfo c = analyze(child);
+                keepLonger(result.required, c.required);
+                if (c.exact) {
+                    run += c.literal;
+                    if (inPrefix) result.prefix += c.literal;
+                    continue;
+                }
+                result.exact = false;
+                keepLonger(result.required, run + c.prefix);
+                if (inPrefix) result.prefix += c.prefix;
+                inPrefix = false;
+                run = c.suffix;
+            }
+            keepLonger(result.required, run);
+            result.suffix = run;
+            if (result.exact) result.literal = run;
+            return result;
+        }
+
+        case NodeType::UNION: {
+            // Only what all alternatives share at their ends survives
+            std::vector<LiteralInfo> alts;
+            for (const auto& child : node->children) alts.push_back(analyze(child));
+            LiteralInfo result = alts.front();
+            for (size_t i = 1; i < alts.size(); ++i) {
+                const LiteralInfo& a = alts[i];
+                if (!(result.exact && a.exact && result.literal == a.literal)) result.exact = false;
+                size_t p = 0;
+                while (p < result.prefix.size() && p < a.prefix.size() && result.prefix[p] == a.prefix[p]) ++p;
+                result.prefix.resize(p);
+                size_t s = 0;
+                while (s < result.suffix.size() && s < a.suffix.size() &&
+                       result.suffix[result.suffix.size() - 1 - s] == a.suffix[a.suffix.size() - 1 - s]) ++s;
+                result.suffix.erase(0, result.suffix.size() - s);
+            }
+            if (!result.exact) {
+                result.literal.clear();
+                result.required = result.prefix.size() >= result.suffix.size() ? result.prefix : result.suffix;
+            }
+            return result;
+        }
+
+        case NodeType::PLUS: {
+            LiteralInfo result = analyze(node->children[0]);
+            result.exact = false;
+            result.literal.clear();
+            return result;
+        }
+
+        case NodeType::REPEAT_N: {
+            LiteralInfo child = analyze(node->children[0]);
+            const int minRep = node->minRepeat;
+            if (minRep == 0) {
+                if (node->maxRepeat == 0) return LiteralInfo::exactly("");
+                return {};
+            }
+            if (child.exact) {
+                LiteralInfo result = LiteralInfo::exactly(repeatString(child.literal, minRep));
+                result.exact = node->maxRepeat == minRep;
+                if (!result.exact) result.literal.clear();
+                return result;
+            }
+            child.exact = false;
+            return child;
+        }
+
+        default:
+            // STAR, OPTIONAL, ANY, multi-character classes
+            return {};
+    }
+}
+
+constexpr size_t UNBOUNDED = SIZE_MAX;
+
+size_t maxLength(const Node& node) {
+    if (!node) return 0;
+    switch (node->type) {
+        case NodeType::EPSILON:
+        case NodeType::START_ANCHOR:
+        case NodeType::END_ANCHOR:
+            return 0;
+        case NodeType::CHAR:
+        case NodeType::CHAR_CLASS:
+        case NodeType::ANY:
+            return 1;
+        case NodeType::GROUP:
+        case NodeType::OPTIONAL:
+            return maxLength(node->children[0]);
+        case NodeType::CONCAT: {
+            size_t total = 0;
+            for (const auto& child : node->children) {
+                size_t c = maxLength(child);
+                if (c == UNBOUNDED) return UNBOUNDED;
+                total += c;
+            }
+            return total;
+        }
+        case NodeType::UNION: {
+            size_t best = 0;
+            for (const auto& child : node->children) best = std::max(best, maxLength(child));
+            return best;
+        }
+        case NodeType::STAR:
+        case NodeType::PLUS: {
+            size_t c = maxLength(node->children[0]);
+            return c == 0 ? 0 : UNBOUNDED;
+        }
+        case NodeType::REPEAT_N: {
+            size_t c = maxLength(node->children[0]);
+            if (c == 0 || node->maxRepeat == 0) return 0;
+            if (c == UNBOUNDED || node->maxRepeat < 0) return UNBOUNDED;
+            size_t times = static_cast<size_t>(std::max(node->minRepeat, node->maxRepeat));
+            return c > UNBOUNDED / times ? UNBOUNDED : c * times;
+        }
+        default:
+            return UNBOUNDED;
+    }
+}
+
+#ifdef AUTOMATA_PREFILTER_X86
+
+// The first, middle and last literal bytes are compared at every position
+// of a block; positions where all three agree are verified with memcmp.
+// Over a four-letter alphabet two probes still pass one position in 16,
+// the third cuts that to one in 64.
+
+__attribute__((target("sse2")))
+size_t findSSE2(const char* data, size_t length, size_t from, const std::string& literal) {
+    const size_t k = literal.size();
+    const size_t mid = k / 2;
+    const __m128i first = _mm_set1_epi8(literal.front());
+    const __m128i middle = _mm_set1_epi8(literal[mid]);
+    const __m128i last = _mm_set1_epi8(literal.back());
+    size_t i = from;
+    for (; i + k - 1 + 16 <= length; i += 16) {
+        __m128i eqFirst = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), first);
+        __m128i eqMiddle = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + mid)), middle);
+        __m128i eqLast = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + k - 1)), last);
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(eqFirst, eqMiddle), eqLast)));
+        while (mask) {
+            size_t p = i + static_cast<size_t>(__builtin_ctz(mask));
+            if (std::memcmp(data + p, literal.data(), k) == 0) return p;
+            mask &= mask - 1;
+        }
+    }
+    return i;  // Caller finishes the tail
+}
+
+__attribute__((target("avx2")))
+size_t findAVX2(const char* data, size_t length, size_t from, const std::string& literal) {
+    const size_t k = literal.size();
+    const size_t mid = k / 2;
+    const __m256i first = _mm256_set1_epi8(literal.front());
+    const __m256i middle = _mm256_set1_epi8(literal[mid]);
+    const __m256i last = _mm256_set1_epi8(literal.back());
+    size_t i = from;
+    for (; i + k - 1 + 32 <= length; i += 32) {
+        __m256i eqFirst = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), first);
+        __m256i eqMiddle = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + mid)), middle);
+        __m256i eqLast = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + k - 1)), last);
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(eqFirst, eqMiddle), eqLast)));
+        while (mask) {
+            size_t p = i + static_cast<size_t>(__builtin_ctz(mask));
+            if (std::memcmp(data + p, literal.data(), k) == 0) return p;
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+#endif // AUTOMATA_PREFILTER_X86
+
+} // namespace
+
+LiteralPrefilter::LiteralPrefilter(const std::string& literal, size_t maxMatchLength)
+    : literal_(literal)
+    , maxMatchLength_(maxMatchLength)
+    , backend_(detectBackend())
+{
+    if (literal_.empty()) {
+        throw std::invalid_argument("Prefilter literal must not be empty");
+    }
+    if (maxMatchLength_ < literal_.size()) {
+        throw std::invalid_argument("Maximum match length is shorter than the literal");
+    }
+}
+
+std::string LiteralPrefilter::requiredLiteral(const std::shared_ptr<RegexParser::ASTNode>& ast) {
+    return analyze(ast).required;
+}
+
+std::optional<size_t> LiteralPrefilter::maxMatchLength(const std::shared_ptr<RegexParser::ASTNode>& ast) {
+    size_t length = maxLength(ast);
+    if (length == UNBOUNDED) return std::nullopt;
+    return length;
+}
+
+std::optional<LiteralPrefilter> LiteralPrefilter::fromAST(const std::shared_ptr<RegexParser::ASTNode>& ast) {
+    std::string literal = requiredLiteral(ast);
+    if (literal.size() < MIN_LITERAL_LENGTH) return std::nullopt;
+    std::optional<size_t> length = maxMatchLength(ast);
+    if (!length) return std::nullopt;
+    return LiteralPrefilter(literal, *length);
+}
+
+LiteralPrefilter::Backend LiteralPrefilter::detectBackend() {
+#ifdef AUTOMATA_PREFILTER_X86
+    static const Backend detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Backend::AVX2;
+        if (__builtin_cpu_supports("sse2")) return Backend::SSE2;
+        return Backend::SCALAR;
+    }();
+    return detected;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+void LiteralPrefilter::setBackend(Backend backend) {
+    backend_ = std::min(backend, detectBackend());
+}
+
+size_t LiteralPrefilter::find(const char* data, size_t length, size_t from) const {
+    const size_t k = literal_.size();
+    if (from > length || length - from < k) return std::string::npos;
+
+    if (k == 1) {
+        const void* hit = std::memchr(data + from, literal_[0], length - from);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - data) : std::string::npos;
+    }
+
+    size_t tail = from;
+#ifdef AUTOMATA_PREFILTER_X86
+    if (backend_ != Backend::SCALAR) {
+        size_t found = backend_ == Backend::AVX2 ? findAVX2(data, length, from, literal_)
+                                                 : findSSE2(data, length, from, literal_);
+        // The kernels return a match, or where their last full block ended
+        if (found + k <= length && std::memcmp(data + found, literal_.data(), k) == 0) return found;
+        tail = found;
+    }
+#endif
+    // memchr on the first byte, then verify
+    for (size_t i = tail; i + k <= length;) {
+        const void* hit = std::memchr(data + i, literal_[0], length - k + 1 - i);
+        if (!hit) break;
+        size_t p = static_cast<size_t>(static_cast<const char*>(hit) - data);
+        if (std::memcmp(data + p, literal_.data(), k) == 0) return p;
+        i = p + 1;
+    }
+    return std::string::npos;
+}
+
+std::optional<std::vector<LiteralPrefilter::Region>> LiteralPrefilter::candidateRegions(
+        const char* data, size_t length, size_t maxRegions) const {
+    std::vector<Region> regions;
+    const size_t k = literal_.size();
+    const size_t span = maxMatchLength_;
+    for (size_t p = find(data, length, 0); p != std::string::npos; p = find(data, length, p + 1)) {
+        size_t begin = p + k >= span ? p + k - span : 0;
+        size_t end = std::min(length, p + span);
+        if (!regions.empty() && begin <= regions.back().second) {
+            regions.back().second = std::max(regions.back().second, end);
+        } else {
+            if (regions.size() == maxRegions) return std::nullopt;
+            regions.emplace_back(begin, end);
+        }
+    }
+    return regions;
+}
+
+} // namespace automata
@@ -0,0 +1,242 @@
+#include "automata/regex_optimizer.hpp"
+
+namespace automata {
+
+RegexOptimizer::Node RegexOptimizer::makeNode(NodeType type, std::vector<Node> children) {
+    auto node = std::make_shared<RegexParser::ASTNode>();
+    node->type = type;
+    node->children = std::move(children);
+    return node;
+}
+
+RegexOptimizer::Node RegexOptimizer::optimize(const Node& node) {
+    if (!node) return node;
+
+    switch (node->type) {
+        case NodeType::GROUP:
+            return optimize(node->children[0]);
+
+        case NodeType::UNION: {
+            // The parser nests binary unions; flatten the whole chain first
+            // so the alternatives are merged and factored once
+            std::vector<Node> operands;
+            std::vector<Node> alternatives;
+            collect(node, NodeType::UNION, operands);
+            for (const auto& operand : operands) {
+                Node c = optimize(operand);
+                if (c && c->type == NodeType::UNION) {
+                    alternatives.insert(alternatives.end(), c->children.begin(), c->children.end());
+                } else {
+                    alternatives.push_back(c);
+                }
+            }
+            return optimizeUnion(std::move(alternatives));
+        }
+
+        case NodeType::CONCAT: {
+            std::vector<Node> operands;
+            std::vector<Node> parts;
+            collect(node, NodeType::CONCAT, operands);
+            for (const auto& operand : operands) {
+                std::vector<Node> seq = sequence(optimize(operand));
+                parts.insert(parts.end(), seq.begin(), seq.end());
+            }
+            return optimizeConcat(parts);
+        }
+
+        case NodeType::STAR:
+        case NodeType::PLUS:
+        case NodeType::OPTIONAL:
+            return optimizeClosure(node->type, optimize(node->children[0]));
+
+        case NodeType::REPEAT_N: {
+            Node child = optimize(node->children[0]);
+            int minRep = node->minRepeat;
+            int maxRep = node->maxRepeat;
+            if (minRep == 0 && maxRep == 0) return makeNode(NodeType::EPSILON);
+            if (minRep == 1 && maxRep == 1) return child;
+            if (minRep == 0 && maxRep == -1) return optimizeClosure(NodeType::STAR, child);
+            if (minRep == 1 && maxRep == -1) return optimizeClosure(NodeType::PLUS, child);
+            if (minRep == 0 && maxRep == 1) return optimizeClosure(NodeType::OPTIONAL, child);
+            auto result = makeNode(NodeType::REPEAT_N, {child});
+            result->minRepeat = minRep;
+            result->maxRepeat = maxRep;
+            return result;
+        }
+
+        default:
+            // Leaves are immutable and can be shared
+            return node;
+    }
+}
+
+RegexOptimizer::Node RegexOptimizer::optimizeUnion(std::vector<Node> alternatives) {
+    // ε (also inside `X?`) is taken out and re-added as `?` at the end;
+    // nested unions are spliced in and duplicates dropped
+    std::vector<Node> kept;
+    std::set<std::string> seen;
+    bool hasEpsilon = false;
+    std::function<void(const Node&)> add = [&](const Node& alt) {
+        if (!alt || alt->type == NodeType::EPSILON) {
+            hasEpsilon = true;
+        } else if (alt->type == NodeType::OPTIONAL) {
+            hasEpsilon = true;
+            add(alt->children[0]);
+        } else if (alt->type == NodeType::UNION) {
+            for (const auto& inner : alt->children) add(inner);
+        } else if (seen.insert(key(alt)).second) {
+            kept.push_back(alt);
+        }
+    };
+    for (const auto& alt : alternatives) add(alt);
+
+    if (kept.size() > 1) {
+        factor(kept, false);
+        factor(kept, true);
+    }
+
+    // Single-symbol alternatives merge into one class at the position of the first
+    std::vector<Node> merged;
+    std::set<char> symbols;
+    size_t classPosition = 0;
+    bool hasClass = false;
+    for (const auto& alt : kept) {
+        if (alt->type == NodeType::CHAR) {
+            symbols.insert(alt->value);
+        } else if (alt->type == NodeType::CHAR_CLASS) {
+            symbols.insert(alt->charClass.begin(), alt->charClass.end());
+        } else if (alt->type == NodeType::ANY) {
+            for (int c = ' '; c < 127; ++c) symbols.insert(static_cast<char>(c));
+        } else {
+            merged.push_back(alt);
+            continue;
+        }
+        if (!hasClass) classPosition = merged.size();
+        hasClass = true;
+    }
+    if (hasClass) {
+        Node symbolNode;
+        if (symbols.size() == 1) {
+            symbolNode = makeNode(NodeType::CHAR);
+            symbolNode->value = *symbols.begin();
+        } else {
+            symbolNode = makeNode(NodeType::CHAR_CLASS);
+            symbolNode->charClass = std::move(symbols);
+        }
+        merged.insert(merged.begin() + static_cast<std::ptrdiff_t>(classPosition), symbolNode);
+    }
+
+    if (merged.empty()) return makeNode(NodeType::EPSILON);
+    Node result = merged.size() == 1 ? merged.front() : makeNode(NodeType::UNION, std::move(merged));
+    return hasEpsilon ? optimizeClosure(NodeType::OPTIONAL, result) : result;
+}
+
+RegexOptimizer::Node RegexOptimizer::optimizeConcat(const std::vector<Node>& parts) {
+    std::vector<Node> kept;
+    for (const auto& part : parts) {
+        if (part && part->type != NodeType::EPSILON) kept.push_back(part);
+    }
+    return fromSequence(std::move(kept));
+}
+
+RegexOptimizer::Node RegexOptimizer::optimizeClosure(NodeType type, const Node& child) {
+    if (!child || child->type == NodeType::EPSILON) return makeNode(NodeType::EPSILON);
+
+    const NodeType inner = child->type;
+    const bool innerClosure = inner == NodeType::STAR || inner == NodeType::PLUS || inner == NodeType::OPTIONAL;
+    if (innerClosure) {
+        // Same operator twice is the operator once; any other mix is a star
+        if (inner == type || inner == NodeType::STAR) return child;
+        return optimizeClosure(NodeType::STAR, child->children[0]);
+    }
+    return makeNode(type, {child});
+}
+
+bool RegexOptimizer::factor(std::vector<Node>& alternatives, bool suffix) {
+    // Group alternatives by their first (last) element, in order of appearance
+    std::vector<std::vector<Node>> groups;
+    std::map<std::string, size_t> groupOf;
+    for (const auto& alt : alternatives) {
+        std::vector<Node> seq = sequence(alt);
+        const std::string k = key(suffix ? seq.back() : seq.front());
+        auto it = groupOf.emplace(k, groups.size()).first;
+        if (it->second == groups.size()) groups.emplace_back();
+        groups[it->second].push_back(alt);
+    }
+    if (groups.size() == alternatives.size()) return false;
+
+    std::vector<Node> factored;
+    for (const auto& group : groups) {
+        if (group.size() == 1) {
+            factored.push_back(group.front());
+            continue;
+        }
+        std::vector<Node> rests;
+        Node shared;
+        for (const auto& alt : group) {
+            std::vector<Node> seq = sequence(alt);
+            shared = suffix ? seq.back() : seq.front();
+            if (suffix) {
+                seq.pop_back();
+            } else {
+                seq.erase(seq.begin());
+            }
+            rests.push_back(fromSequence(std::move(seq)));
+        }
+        std::vector<Node> parts = sequence(optimizeUnion(std::move(rests)));
+        if (suffix) {
+            parts.push_back(shared);
+        } else {
+            parts.insert(parts.begin(), shared);
+        }
+        factored.push_back(optimizeConcat(parts));
+    }
+    alternatives = std::move(factored);
+    return true;
+}
+
+void RegexOptimizer::collect(const Node& node, NodeType type, std::vector<Node>& operands) {
+    if (node && node->type == NodeType::GROUP && node->children[0] && node->children[0]->type == type) {
+        collect(node->children[0], type, operands);
+    } else if (node && node->type == type) {
+        for (const auto& child : node->children) collect(child, type, operands);
+    } else {
+        operands.push_back(node);
+    }
+}
+
+std::vector<RegexOptimizer::Node> RegexOptimizer::sequence(const Node& node) {
+    if (node && node->type == NodeType::CONCAT) return node->children;
+    return {node};
+}
+
+RegexOptimizer::Node RegexOptimizer::fromSequence(std::vector<Node> parts) {
+    if (parts.empty()) return makeNode(NodeType::EPSILON);
+    if (parts.size() == 1) return parts.front();
+    return makeNode(NodeType::CONCAT, std::move(parts));
+}
+
+std::string RegexOptimizer::key(const Node& node) {
+    if (!node) return "e";
+    switch (node->type) {
+        case NodeType::EPSILON: return "e";
+        case NodeType::CHAR: return std::string("c") + node->value;
+        case NodeType::ANY: return ".";
+        case NodeType::START_ANCHOR: return "^";
+        case NodeType::END_ANCHOR: return "$";
+        case NodeType::CHAR_CLASS:
+            return "[" + std::to_string(node->charClass.size()) + ":" +
+                   std::string(node->charClass.begin(), node->charClass.end());
+        default: {
+            std::string result = std::to_string(static_cast<int>(node->type));
+            if (node->type == NodeType::REPEAT_N) {
+                result += "{" + std::to_string(node->minRepeat) + "," + std::to_string(node->maxRepeat) + "}";
+            }
+            result += "(";
+            for (const auto& child : node->children) result += key(child) + ",";
+            return result + ")";
+        }
+    }
+}
+
+} // namespace automata
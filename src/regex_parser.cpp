@@ -1,26 +1,40 @@
 #include "automata/regex_parser.hpp"
+#include "automata/regex_optimizer.hpp"
 #include "automata/json_serializer.hpp"
+#include <limits>
 
 namespace automata {
 
-RegexParser::RegexParser() : pos_(0) {}
+RegexParser::RegexParser() : pos_(0), optimize_(true) {}
 
 NFA RegexParser::parse(const std::string& pattern) {
+    if (pattern.empty()) {
+        pattern_ = pattern;
+        pos_ = 0;
+        return NFA::createEmpty();
+    }
+    
+    auto ast = parseAST(pattern);
+    return buildNFA(optimize_ ? RegexOptimizer::optimize(ast) : ast);
+}
+
+std::shared_ptr<RegexParser::ASTNode> RegexParser::parseAST(const std::string& pattern) {
     pattern_ = pattern;
     pos_ = 0;
     
     if (pattern_.empty()) {
-        return NFA::createEmpty();
+        ast_ = std::make_shared<ASTNode>();
+        ast_->type = NodeType::EPSILON;
+    } else {
+        ast_ = parseUnion();
     }
-    
-    ast_ = parseUnion();
     astString_ = ast_ ? ast_->toString() : "";
     
     if (!isAtEnd()) {
         throw ParseException("Unexpected character at position " + std::to_string(pos_));
     }
     
-    return buildNFA(ast_);
+    return ast_;
 }
 
 std::shared_ptr<RegexParser::ASTNode> RegexParser::parseUnion() {
@@ -251,11 +265,26 @@ int RegexParser::parseNumber() {
     bool hasDigit = false;
     while (!isAtEnd() && std::isdigit(peek())) {
         hasDigit = true;
-        num = num * 10 + (advance() - '0');
+        int digit = advance() - '0';
+        if (num > (std::numeric_limits<int>::max() - digit) / 10) {
+            throw ParseException("Number too large at position " + std::to_string(pos_ - 1));
+        }
+        num = num * 10 + digit;
     }
     return hasDigit ? num : -1;
 }
 
+void RegexParser::checkRepeatBounds(int minRep, int maxRep) const {
+    if (minRep > MAX_REPEAT || maxRep > MAX_REPEAT) {
+        throw ParseException("Repetition bound above " + std::to_string(MAX_REPEAT) + " before position " +
+                             std::to_string(pos_));
+    }
+    if (maxRep >= 0 && minRep > maxRep) {
+        throw ParseException("Repetition {" + std::to_string(minRep) + "," + std::to_string(maxRep) +
+                             "} has min > max");
+    }
+}
+
 bool RegexParser::parseCountedQuantifier(int& minRep, int& maxRep) {
     // Save position in case we need to backtrack
     size_t startPos = pos_;
@@ -275,6 +304,7 @@ bool RegexParser::parseCountedQuantifier(int& minRep, int& maxRep) {
         // {m} - exact repetition
         advance();
         maxRep = minRep;
+        checkRepeatBounds(minRep, maxRep);
         return true;
     } else if (peek() == ',') {
         advance();  // consume ','
@@ -283,6 +313,7 @@ bool RegexParser::parseCountedQuantifier(int& minRep, int& maxRep) {
             // {m,} - at least m
             advance();
             maxRep = -1;  // -1 means unlimited
+            checkRepeatBounds(minRep, maxRep);
             return true;
         } else {
             // {m,n}
@@ -292,6 +323,7 @@ bool RegexParser::parseCountedQuantifier(int& minRep, int& maxRep) {
                 return false;
             }
             advance();  // consume '}'
+            checkRepeatBounds(minRep, maxRep);
             return true;
         }
     } else {
@@ -301,71 +333,76 @@ bool RegexParser::parseCountedQuantifier(int& minRep, int& maxRep) {
 }
 
 NFA RegexParser::buildNFA(const std::shared_ptr<ASTNode>& node) {
-    if (!node) return NFA::createEmpty();
+    NFABuilder builder;
+    return builder.build(buildFragment(builder, node));
+}
+
+NFABuilder::Fragment RegexParser::buildFragment(NFABuilder& builder, const std::shared_ptr<ASTNode>& node) {
+    if (!node) return builder.empty();
     
     switch (node->type) {
         case NodeType::EPSILON:
-            return NFA::createEmpty();
+            return builder.empty();
             
         case NodeType::CHAR:
-            return NFA::createSingle(node->value);
+            return builder.single(node->value);
             
         case NodeType::ANY: {
             // Match any printable ASCII
-            NFA result = NFA::createSingle(' ');
-            for (int c = '!' ; c < 127; ++c) {
-                result = NFA::createUnion(std::move(result), NFA::createSingle(static_cast<char>(c)));
-            }
-            return result;
+            SymbolSet printable;
+            printable.addRange(' ', '~');
+            return builder.symbols(printable);
         }
             
         case NodeType::CHAR_CLASS: {
             if (node->charClass.empty()) {
-                return NFA::createEmpty();
+                return builder.empty();
             }
-            auto it = node->charClass.begin();
-            NFA result = NFA::createSingle(*it);
-            ++it;
-            while (it != node->charClass.end()) {
-                result = NFA::createUnion(std::move(result), NFA::createSingle(*it));
-                ++it;
-            }
-            return result;
+            SymbolSet members;
+            for (char c : node->charClass) members.add(c);
+            if (members.empty()) return builder.empty();
+            if (members.size() == 1) return builder.single(members.members().front());
+            return builder.symbols(members);
         }
             
-        case NodeType::UNION:
-            return NFA::createUnion(
-                buildNFA(node->children[0]),
-                buildNFA(node->children[1])
-            );
+        case NodeType::UNION: {
+            // Binary from the parser, n-ary after optimization
+            std::vector<NFABuilder::Fragment> alternatives;
+            for (const auto& child : node->children) {
+                alternatives.push_back(buildFragment(builder, child));
+            }
+            return builder.alternate(alternatives);
+        }
             
-        case NodeType::CONCAT:
-            return NFA::createConcat(
-                buildNFA(node->children[0]),
-                buildNFA(node->children[1])
-            );
+        case NodeType::CONCAT: {
+            NFABuilder::Fragment result = buildFragment(builder, node->children[0]);
+            for (size_t i = 1; i < node->children.size(); ++i) {
+                result = builder.concat(result, buildFragment(builder, node->children[i]));
+            }
+            return result;
+        }
             
         case NodeType::STAR:
-            return NFA::createStar(buildNFA(node->children[0]));
+            return builder.star(buildFragment(builder, node->children[0]));
             
         case NodeType::PLUS:
-            return NFA::createPlus(buildNFA(node->children[0]));
+            return builder.plus(buildFragment(builder, node->children[0]));
             
         case NodeType::OPTIONAL:
-            return NFA::createOptional(buildNFA(node->children[0]));
+            return builder.optional(buildFragment(builder, node->children[0]));
             
         case NodeType::GROUP:
-            return buildNFA(node->children[0]);
+            return buildFragment(builder, node->children[0]);
         
         case NodeType::START_ANCHOR:
             // Start anchor is a zero-width assertion - in NFA we represent it as epsilon
             // The actual anchoring logic is handled during matching
-            return NFA::createEmpty();
+            return builder.empty();
             
         case NodeType::END_ANCHOR:
             // End anchor is a zero-width assertion - in NFA we represent it as epsilon
             // The actual anchoring logic is handled during matching
-            return NFA::createEmpty();
+            return builder.empty();
             
         case NodeType::REPEAT_N: {
             // {m,n} - repeat child between m and n times
@@ -375,30 +412,39 @@ NFA RegexParser::buildNFA(const std::shared_ptr<ASTNode>& node) {
             int maxRep = node->maxRepeat;
             
             if (minRep == 0 && maxRep == 0) {
-                return NFA::createEmpty();
+                return builder.empty();
             }
             
-            NFA childNFA = buildNFA(node->children[0]);
+            // The child is built once; further repetitions copy its state range
+            NFABuilder::Fragment child = buildFragment(builder, node->children[0]);
+            bool childUsed = false;
+            auto nextCopy = [&]() {
+                if (childUsed) return builder.copy(child);
+                childUsed = true;
+                return child;
+            };
+            
+            std::optional<NFABuilder::Fragment> result;
+            auto append = [&](const NFABuilder::Fragment& part) {
+                result = result ? builder.concat(*result, part) : part;
+            };
             
             // Build the required minimum repetitions
-            NFA result = NFA::createEmpty();
             for (int i = 0; i < minRep; ++i) {
-                result = NFA::createConcat(std::move(result), buildNFA(node->children[0]));
+                append(nextCopy());
             }
             
             if (maxRep == -1) {
                 // {m,} means minRep required, then Kleene star
-                NFA star = NFA::createStar(buildNFA(node->children[0]));
-                result = NFA::createConcat(std::move(result), std::move(star));
+                append(builder.star(nextCopy()));
             } else {
                 // {m,n} means minRep required, then up to (maxRep - minRep) optional
                 for (int i = minRep; i < maxRep; ++i) {
-                    NFA optional = NFA::createOptional(buildNFA(node->children[0]));
-                    result = NFA::createConcat(std::move(result), std::move(optional));
+                    append(builder.optional(nextCopy()));
                 }
             }
             
-            return result;
+            return result ? *result : builder.empty();
         }
             
         default:
@@ -417,10 +463,19 @@ std::string RegexParser::ASTNode::toString() const {
             s += "]";
             return s;
         }
-        case NodeType::UNION:
-            return "(" + children[0]->toString() + "|" + children[1]->toString() + ")";
-        case NodeType::CONCAT:
-            return children[0]->toString() + children[1]->toString();
+        case NodeType::UNION: {
+            std::string s = "(";
+            for (size_t i = 0; i < children.size(); ++i) {
+                if (i > 0) s += "|";
+                s += children[i]->toString();
+            }
+            return s + ")";
+        }
+        case NodeType::CONCAT: {
+            std::string s;
+            for (const auto& child : children) s += child->toString();
+            return s;
+        }
         case NodeType::STAR:
             return "(" + children[0]->toString() + ")*";
         case NodeType::PLUS:
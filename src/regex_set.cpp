@@ -0,0 +1,179 @@
+#include "automata/regex_set.hpp"
+#include "automata/regex_parser.hpp"
+
+namespace automata {
+
+RegexSet::RegexSet()
+    : columnCount_(1), strideShift_(0), start_(0), stateCount_(0) {
+    columns_.fill(0);
+}
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns)
+    : RegexSet(patterns, Options()) {}
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns, const Options& options) : RegexSet() {
+    options_ = options;
+    std::vector<CompiledDFA> dfas;
+    dfas.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+        RegexParser parser;
+        dfas.push_back(CompiledDFA::fromDFA(DFA::fromNFA(parser.parse(pattern)).minimize()));
+    }
+    build(dfas);
+}
+
+RegexSet RegexSet::fromDFAs(const std::vector<DFA>& dfas) {
+    return fromDFAs(dfas, Options());
+}
+
+RegexSet RegexSet::fromDFAs(const std::vector<DFA>& dfas, const Options& options) {
+    RegexSet set;
+    set.options_ = options;
+    std::vector<CompiledDFA> compiled;
+    compiled.reserve(dfas.size());
+    for (const auto& dfa : dfas) compiled.push_back(CompiledDFA::fromDFA(dfa));
+    set.build(compiled);
+    return set;
+}
+
+void RegexSet::build(const std::vector<CompiledDFA>& dfas) {
+    const size_t n = dfas.size();
+    std::vector<CompiledDFA> forward;
+    forward.reserve(n);
+    reverse_.clear();
+    for (const auto& dfa : dfas) {
+        forward.push_back(dfa.unanchored());
+        reverse_.push_back(dfa.reversed(false));
+    }
+
+    // Common refinement of the operands' byte classes: two bytes share a
+    // column iff every operand puts them in the same column
+    std::map<std::vector<uint8_t>, uint8_t> columnOf;
+    std::vector<unsigned char> representative;
+    for (int b = 0; b < 256; ++b) {
+        std::vector<uint8_t> key(n);
+        for (size_t i = 0; i < n; ++i) key[i] = forward[i].getColumn(static_cast<unsigned char>(b));
+        auto it = columnOf.emplace(std::move(key), static_cast<uint8_t>(representative.size())).first;
+        if (it->second == representative.size()) representative.push_back(static_cast<unsigned char>(b));
+        columns_[b] = it->second;
+    }
+    columnCount_ = representative.size();
+    strideShift_ = 0;
+    while ((size_t{1} << strideShift_) < columnCount_) ++strideShift_;
+    const size_t stride = size_t{1} << strideShift_;
+
+    // Breadth-first product construction; a state is the tuple of component states
+    std::map<std::vector<CompiledDFA::Index>, Index> stateMap;
+    std::vector<std::vector<CompiledDFA::Index>> tuples;
+    auto intern = [&](std::vector<CompiledDFA::Index>& tuple) -> Index {
+        auto it = stateMap.find(tuple);
+        if (it != stateMap.end()) return it->second;
+        if (tuples.size() >= options_.maxStates) {
+            throw AutomataException("RegexSet exceeds " + std::to_string(options_.maxStates) + " DFA states");
+        }
+        Index id = static_cast<Index>(tuples.size());
+        stateMap.emplace(tuple, id);
+        tuples.push_back(tuple);
+        return id;
+    };
+
+    std::vector<CompiledDFA::Index> tuple(n);
+    for (size_t i = 0; i < n; ++i) tuple[i] = forward[i].getStartState();
+    table_.clear();
+    start_ = intern(tuple);
+    for (size_t s = 0; s < tuples.size(); ++s) {
+        table_.resize((s + 1) * stride, 0);
+        for (size_t col = 0; col < columnCount_; ++col) {
+            for (size_t i = 0; i < n; ++i) tuple[i] = forward[i].next(tuples[s][i], representative[col]);
+            Index target = intern(tuple);
+            table_[s * stride + col] = target;
+        }
+    }
+    stateCount_ = tuples.size();
+
+    matchStart_.assign(stateCount_ + 1, 0);
+    matchPatterns_.clear();
+    for (size_t s = 0; s < stateCount_; ++s) {
+        for (size_t i = 0; i < n; ++i) {
+            if (forward[i].isAccepting(tuples[s][i])) matchPatterns_.push_back(static_cast<uint32_t>(i));
+        }
+        matchStart_[s + 1] = static_cast<uint32_t>(matchPatterns_.size());
+    }
+}
+
+std::vector<size_t> RegexSet::getMatchingPatterns(Index state) const {
+    return std::vector<size_t>(matchPatterns_.begin() + matchStart_[state],
+                               matchPatterns_.begin() + matchStart_[state + 1]);
+}
+
+bool RegexSet::isMatch(const std::string& text) const {
+    Index state = start_;
+    if (isAccepting(state)) return true;
+    for (unsigned char c : text) {
+        state = next(state, c);
+        if (isAccepting(state)) return true;
+    }
+    return false;
+}
+
+std::vector<size_t> RegexSet::matches(const std::string& text) const {
+    std::vector<bool> seen(getPatternCount(), false);
+    size_t remaining = getPatternCount();
+    auto record = [&](Index state) {
+        for (uint32_t k = matchStart_[state]; k < matchStart_[state + 1]; ++k) {
+            if (!seen[matchPatterns_[k]]) {
+                seen[matchPatterns_[k]] = true;
+                --remaining;
+            }
+        }
+    };
+
+    Index state = start_;
+    record(state);
+    for (size_t i = 0; i < text.size() && remaining > 0; ++i) {
+        state = next(state, static_cast<unsigned char>(text[i]));
+        if (isAccepting(state)) record(state);
+    }
+
+    std::vector<size_t> result;
+    for (size_t p = 0; p < seen.size(); ++p) {
+        if (seen[p]) result.push_back(p);
+    }
+    return result;
+}
+
+std::vector<RegexSet::Match> RegexSet::findAll(const std::string& text) const {
+    std::vector<Match> found;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+
+    // Every pattern accepting at an end scans backwards for its starts
+    auto collect = [&](Index state, size_t end) {
+        for (uint32_t k = matchStart_[state]; k < matchStart_[state + 1]; ++k) {
+            const size_t pattern = matchPatterns_[k];
+            const CompiledDFA& reverse = reverse_[pattern];
+            CompiledDFA::Index r = reverse.getStartState();
+            if (reverse.isAccepting(r)) found.push_back({pattern, end, end});
+            for (size_t p = end; p > 0; --p) {
+                r = reverse.next(r, bytes[p - 1]);
+                if (r == CompiledDFA::DEAD) break;
+                if (reverse.isAccepting(r)) found.push_back({pattern, p - 1, end});
+            }
+        }
+    };
+
+    Index state = start_;
+    if (isAccepting(state)) collect(state, 0);
+    for (size_t i = 0; i < text.size(); ++i) {
+        state = next(state, bytes[i]);
+        if (isAccepting(state)) collect(state, i + 1);
+    }
+
+    std::sort(found.begin(), found.end(), [](const Match& a, const Match& b) {
+        if (a.start != b.start) return a.start < b.start;
+        if (a.end != b.end) return a.end < b.end;
+        return a.pattern < b.pattern;
+    });
+    return found;
+}
+
+} // namespace automata
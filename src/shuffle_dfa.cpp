@@ -0,0 +1,318 @@
+#include "automata/shuffle_dfa.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AUTOMATA_SHUFFLE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace automata {
+
+namespace {
+
+// Byte consumed at step k, and the text offset reached after it
+template <bool Backward>
+inline unsigned char byteAt(const unsigned char* data, size_t length, size_t k) {
+    return Backward ? data[length - 1 - k] : data[k];
+}
+
+template <bool Backward>
+inline size_t offsetAfter(size_t length, size_t k) {
+    return Backward ? length - 1 - k : k + 1;
+}
+
+// Steps [from, to) from state; returns the state after them
+template <bool Backward>
+uint8_t acceptingScalar(const ShuffleDFA& dfa, uint8_t state, const unsigned char* data, size_t length,
+                        size_t from, size_t to, std::vector<size_t>& positions) {
+    for (size_t k = from; k < to; ++k) {
+        state = dfa.next(state, byteAt<Backward>(data, length, k));
+        if (ShuffleDFA::isAccepting(state)) positions.push_back(offsetAfter<Backward>(length, k));
+    }
+    return state;
+}
+
+#ifdef AUTOMATA_SHUFFLE_X86
+
+__attribute__((target("ssse3")))
+uint8_t runSSSE3(const uint8_t* shuffles, const uint8_t* columns, uint8_t state,
+                 const unsigned char* data, size_t length) {
+    __m128i s = _mm_set1_epi8(static_cast<char>(state));
+    constexpr size_t BLOCK = 32;
+    size_t i = 0;
+    while (length - i >= BLOCK) {
+        for (size_t j = 0; j < BLOCK; ++j) {
+            __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffles + (columns[data[i + j]] << 4)));
+            s = _mm_shuffle_epi8(t, s);
+        }
+        i += BLOCK;
+        if ((_mm_cvtsi128_si32(s) & ShuffleDFA::STATE_MASK) == 0) return 0;
+    }
+    for (; i < length; ++i) {
+        __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffles + (columns[data[i]] << 4)));
+        s = _mm_shuffle_epi8(t, s);
+    }
+    return static_cast<uint8_t>(_mm_cvtsi128_si32(s));
+}
+
+__attribute__((target("avx2")))
+uint8_t runAVX2(const uint8_t* shuffles, const uint8_t* columns, uint8_t state,
+                const unsigned char* data, size_t length) {
+    // Low lane: the real state over the first half. High lane: every state
+    // at once over the second half, i.e. that half's whole transition function.
+    const size_t half = length / 2;
+    const unsigned char* second = data + half;
+    __m256i s = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_set1_epi8(static_cast<char>(state))),
+        _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), 1);
+
+    constexpr size_t BLOCK = 32;
+    size_t i = 0;
+    while (i < half) {
+        size_t end = std::min(half, i + BLOCK);
+        for (; i < end; ++i) {
+            __m256i t = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffles + (columns[data[i]] << 4)))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffles + (columns[second[i]] << 4))), 1);
+            s = _mm256_shuffle_epi8(t, s);
+        }
+        // The dead state maps to itself in the high lane too
+        if ((_mm_cvtsi128_si32(_mm256_castsi256_si128(s)) & ShuffleDFA::STATE_MASK) == 0) return 0;
+    }
+
+    alignas(16) uint8_t composed[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(composed), _mm256_extracti128_si256(s, 1));
+    uint8_t middle = static_cast<uint8_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(s)));
+    if (half > 0) state = composed[middle & ShuffleDFA::STATE_MASK];
+    return runSSSE3(shuffles, columns, state, data + 2 * half, length - 2 * half);
+}
+
+template <bool Backward>
+__attribute__((target("ssse3")))
+uint8_t acceptingSSSE3(const ShuffleDFA& dfa, const uint8_t* shuffles, const uint8_t* columns, uint8_t state,
+                       const unsigned char* data, size_t length, size_t from, size_t to,
+                       std::vector<size_t>& positions) {
+    // OR every state of a block together; only blocks that saw the accept
+    // flag are replayed with the scalar loop to recover offsets
+    __m128i s = _mm_set1_epi8(static_cast<char>(state));
+    constexpr size_t BLOCK = 16;
+    size_t k = from;
+    while (to - k >= BLOCK) {
+        uint8_t blockStart = static_cast<uint8_t>(_mm_cvtsi128_si32(s));
+        __m128i seen = _mm_setzero_si128();
+        for (size_t j = 0; j < BLOCK; ++j) {
+            unsigned char byte = byteAt<Backward>(data, length, k + j);
+            __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffles + (columns[byte] << 4)));
+            s = _mm_shuffle_epi8(t, s);
+            seen = _mm_or_si128(seen, s);
+        }
+        if (_mm_cvtsi128_si32(seen) & ShuffleDFA::ACCEPT_FLAG) {
+            acceptingScalar<Backward>(dfa, blockStart, data, length, k, k + BLOCK, positions);
+        }
+        k += BLOCK;
+        if (ShuffleDFA::isDead(static_cast<uint8_t>(_mm_cvtsi128_si32(s)))) return 0;
+    }
+    return acceptingScalar<Backward>(dfa, static_cast<uint8_t>(_mm_cvtsi128_si32(s)), data, length, k, to, positions);
+}
+
+template <bool Backward>
+__attribute__((target("avx2")))
+void acceptingAVX2(const ShuffleDFA& dfa, const uint8_t* shuffles, const uint8_t* pairs, size_t columnCount,
+                   const uint8_t* columns, const unsigned char* data, size_t length,
+                   std::vector<size_t>& positions) {
+    // Low lane: the real state over the first half. High lane: every state
+    // over the second half. Once all live states collapse into one (search
+    // automata synchronize within a few bytes) the high lane's accept flags
+    // are exact; the steps before that are replayed when the real state
+    // entering the second half is known. The dead state is left out: if the
+    // real state dies, the scan ends in the first half.
+    constexpr size_t BLOCK = 16;
+    const size_t half = length / 2 / BLOCK * BLOCK;
+    __m256i s = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_set1_epi8(static_cast<char>(dfa.getStartState()))),
+        _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), 1);
+
+    const int live = ((1 << dfa.getStateCount()) - 1) & ~1;
+    std::vector<size_t> synchronized;  // High-lane offsets from syncedAt on
+    size_t syncedAt = 2 * half;
+    alignas(32) uint8_t before[32], after[32], seen[32];
+    for (size_t k = 0; k < half; k += BLOCK) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(before), s);
+        __m256i flags = _mm256_setzero_si256();
+        for (size_t j = 0; j < BLOCK; ++j) {
+            unsigned char low = byteAt<Backward>(data, length, k + j);
+            unsigned char high = byteAt<Backward>(data, length, half + k + j);
+            // Both lanes' shuffles in one load, which beats assembling them per step
+            size_t pair = static_cast<size_t>(columns[low]) * columnCount + columns[high];
+            __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + (pair << 5)));
+            s = _mm256_shuffle_epi8(t, s);
+            flags = _mm256_or_si256(flags, s);
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(after), s);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(seen), flags);
+        if (seen[0] & ShuffleDFA::ACCEPT_FLAG) {
+            acceptingScalar<Backward>(dfa, before[0], data, length, k, k + BLOCK, positions);
+        }
+        if (syncedAt < 2 * half && (seen[17] & ShuffleDFA::ACCEPT_FLAG)) {
+            acceptingScalar<Backward>(dfa, before[17], data, length, half + k, half + k + BLOCK, synchronized);
+        }
+        // The real state is dead for the rest of the input
+        if (ShuffleDFA::isDead(after[0])) return;
+        if (syncedAt == 2 * half) {
+            __m128i states = _mm256_extracti128_si256(s, 1);
+            __m128i first = _mm_set1_epi8(static_cast<char>(after[17]));
+            if ((_mm_movemask_epi8(_mm_cmpeq_epi8(states, first)) & live) == live) syncedAt = half + k + BLOCK;
+        }
+    }
+
+    uint8_t state = half > 0 ? after[0] : dfa.getStartState();
+    state = acceptingSSSE3<Backward>(dfa, shuffles, columns, state, data, length, half, syncedAt, positions);
+    if (syncedAt < 2 * half) {
+        positions.insert(positions.end(), synchronized.begin(), synchronized.end());
+        state = after[17];
+    }
+    if (ShuffleDFA::isDead(state)) return;
+    acceptingSSSE3<Backward>(dfa, shuffles, columns, state, data, length, 2 * half, length, positions);
+}
+
+#endif // AUTOMATA_SHUFFLE_X86
+
+} // namespace
+
+ShuffleDFA::ShuffleDFA() : start_(0), stateCount_(1), columnCount_(1), backend_(detectBackend()) {
+    columns_.fill(0);
+    shuffles_.assign(16, 0);
+}
+
+ShuffleDFA ShuffleDFA::fromCompiled(const CompiledDFA& dfa) {
+    if (!fits(dfa)) {
+        throw std::invalid_argument("ShuffleDFA supports at most 16 states, got " +
+                                    std::to_string(dfa.getStateCount()));
+    }
+
+    auto encode = [&dfa](CompiledDFA::Index s) -> uint8_t {
+        return static_cast<uint8_t>(s) | (dfa.isAccepting(s) ? ACCEPT_FLAG : 0);
+    };
+
+    ShuffleDFA result;
+    result.stateCount_ = dfa.getStateCount();
+    result.columnCount_ = dfa.getColumnCount();
+    result.start_ = encode(dfa.getStartState());
+
+    // Pick one byte per column to read the transition function from;
+    // unused shuffle entries stay 0 (dead)
+    std::vector<int> representative(dfa.getColumnCount(), -1);
+    for (int b = 0; b < 256; ++b) {
+        uint8_t col = dfa.getColumn(static_cast<unsigned char>(b));
+        result.columns_[b] = col;
+        if (representative[col] < 0) representative[col] = b;
+    }
+
+    result.shuffles_.assign(dfa.getColumnCount() * 16, 0);
+    for (size_t col = 0; col < dfa.getColumnCount(); ++col) {
+        if (representative[col] < 0) continue;
+        for (CompiledDFA::Index s = 0; s < dfa.getStateCount(); ++s) {
+            result.shuffles_[(col << 4) | s] = encode(dfa.next(s, static_cast<unsigned char>(representative[col])));
+        }
+    }
+
+    // Concatenated shuffles for every (column, column) pair, 32 bytes each
+    if (result.columnCount_ <= MAX_PAIR_COLUMNS) {
+        const size_t columns = result.columnCount_;
+        result.pairs_.resize(columns * columns * 32);
+        for (size_t low = 0; low < columns; ++low) {
+            for (size_t high = 0; high < columns; ++high) {
+                uint8_t* pair = &result.pairs_[(low * columns + high) * 32];
+                std::copy_n(&result.shuffles_[low << 4], 16, pair);
+                std::copy_n(&result.shuffles_[high << 4], 16, pair + 16);
+            }
+        }
+    }
+    return result;
+}
+
+ShuffleDFA ShuffleDFA::fromDFA(const DFA& dfa) {
+    return fromCompiled(CompiledDFA::fromDFA(dfa));
+}
+
+ShuffleDFA::Backend ShuffleDFA::detectBackend() {
+#ifdef AUTOMATA_SHUFFLE_X86
+    static const Backend detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Backend::AVX2;
+        if (__builtin_cpu_supports("ssse3")) return Backend::SSSE3;
+        return Backend::SCALAR;
+    }();
+    return detected;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+std::string ShuffleDFA::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::AVX2: return "avx2";
+        case Backend::SSSE3: return "ssse3";
+        default: return "scalar";
+    }
+}
+
+void ShuffleDFA::setBackend(Backend backend) {
+    backend_ = std::min(backend, detectBackend());
+}
+
+uint8_t ShuffleDFA::run(uint8_t state, const char* data, size_t length) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+#ifdef AUTOMATA_SHUFFLE_X86
+    // Splitting in halves only pays off once the setup is amortized
+    if (backend_ == Backend::AVX2 && length >= 256) {
+        return runAVX2(shuffles_.data(), columns_.data(), state, bytes, length);
+    }
+    if (backend_ != Backend::SCALAR) {
+        return runSSSE3(shuffles_.data(), columns_.data(), state, bytes, length);
+    }
+#endif
+    for (size_t i = 0; i < length; ++i) state = next(state, bytes[i]);
+    return state;
+}
+
+bool ShuffleDFA::accepts(const std::string& input) const {
+    return accepts(input.data(), input.size());
+}
+
+bool ShuffleDFA::accepts(const char* data, size_t length) const {
+    return isAccepting(run(start_, data, length));
+}
+
+void ShuffleDFA::findAccepting(const char* data, size_t length, bool backward,
+                               std::vector<size_t>& positions) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    if (isAccepting(start_)) positions.push_back(backward ? length : 0);
+#ifdef AUTOMATA_SHUFFLE_X86
+    // As in run(), the two-lane split needs some input to pay off
+    if (backend_ == Backend::AVX2 && !pairs_.empty() && length >= 256) {
+        if (backward) {
+            acceptingAVX2<true>(*this, shuffles_.data(), pairs_.data(), columnCount_, columns_.data(),
+                                bytes, length, positions);
+        } else {
+            acceptingAVX2<false>(*this, shuffles_.data(), pairs_.data(), columnCount_, columns_.data(),
+                                 bytes, length, positions);
+        }
+        return;
+    }
+    if (backend_ != Backend::SCALAR) {
+        if (backward) {
+            acceptingSSSE3<true>(*this, shuffles_.data(), columns_.data(), start_, bytes, length, 0, length, positions);
+        } else {
+            acceptingSSSE3<false>(*this, shuffles_.data(), columns_.data(), start_, bytes, length, 0, length, positions);
+        }
+        return;
+    }
+#endif
+    if (backward) {
+        acceptingScalar<true>(*this, start_, bytes, length, 0, length, positions);
+    } else {
+        acceptingScalar<false>(*this, start_, bytes, length, 0, length, positions);
+    }
+}
+
+} // namespace automata
@@ -0,0 +1,159 @@
+#include "automata/stream_matcher.hpp"
+
+namespace automata {
+
+StreamMatcher::StreamMatcher(const DFA& dfa, MatchKind kind, Callback onMatch)
+    : StreamMatcher(dfa, kind, std::move(onMatch), Options()) {}
+
+StreamMatcher::StreamMatcher(const DFA& dfa, MatchKind kind, Callback onMatch, const Options& options)
+    : kind_(kind), onMatch_(std::move(onMatch)), options_(options),
+      base_(0), state_(CompiledDFA::DEAD), started_(false) {
+    CompiledDFA compiled = CompiledDFA::fromDFA(dfa);
+    if (kind == MatchKind::ALL_OVERLAPPING) {
+        forward_ = compiled.unanchored();
+        reverse_ = compiled.reversed(false);
+    } else {
+        forward_ = compiled;
+        reverse_ = compiled.reversed(true);
+        if (ShuffleDFA::fits(reverse_)) scanner_ = ShuffleDFA::fromCompiled(reverse_);
+    }
+
+    // Pref(L): the same automaton with every state that can still reach an
+    // accepting state made accepting
+    DFA prefixes = dfa;
+    std::map<StateId, std::vector<StateId>> predecessors;
+    for (const auto& t : dfa.getTransitions()) predecessors[t.getTo()].push_back(t.getFrom());
+    std::set<StateId> live = dfa.getAcceptingStates();
+    std::vector<StateId> work(live.begin(), live.end());
+    while (!work.empty()) {
+        StateId s = work.back();
+        work.pop_back();
+        for (StateId p : predecessors[s]) {
+            if (live.insert(p).second) work.push_back(p);
+        }
+    }
+    for (StateId s : live) prefixes.setAcceptingState(s, true);
+    openPrefixes_ = CompiledDFA::fromDFA(prefixes).reversed(false);
+
+    reset();
+}
+
+void StreamMatcher::reset() {
+    buffer_.clear();
+    base_ = 0;
+    state_ = forward_.getStartState();
+    started_ = false;
+}
+
+void StreamMatcher::feed(const char* data, size_t length) {
+    buffer_.append(data, length);
+    process(length, false);
+    if (buffer_.size() > options_.maxCarryBytes) {
+        throw AutomataException("StreamMatcher carry-over exceeds " +
+                                std::to_string(options_.maxCarryBytes) + " bytes");
+    }
+}
+
+void StreamMatcher::finish() {
+    process(0, true);
+    reset();
+}
+
+void StreamMatcher::process(size_t fresh, bool final) {
+    const size_t n = buffer_.size();
+    size_t keep;
+    if (kind_ == MatchKind::ALL_OVERLAPPING) {
+        // Σ*L accepts exactly at match ends; only the new bytes are scanned
+        if (!started_) {
+            started_ = true;
+            if (forward_.isAccepting(state_)) reportEnding(0);
+        }
+        for (size_t i = n - fresh; i < n; ++i) {
+            state_ = forward_.next(state_, static_cast<unsigned char>(buffer_[i]));
+            if (forward_.isAccepting(state_)) reportEnding(i + 1);
+        }
+        keep = final ? n : std::min(firstOpenPosition(), n);
+    } else {
+        const size_t firstOpen = final ? n + 1 : firstOpenPosition();
+        keep = std::min(std::max(reportLeftmost(firstOpen), firstOpen), n);
+    }
+    buffer_.erase(0, keep);
+    base_ += keep;
+}
+
+size_t StreamMatcher::firstOpenPosition() const {
+    const size_t n = buffer_.size();
+    CompiledDFA::Index state = openPrefixes_.getStartState();
+    size_t first = openPrefixes_.isAccepting(state) ? n : n + 1;
+    for (size_t p = n; p > 0; --p) {
+        state = openPrefixes_.next(state, static_cast<unsigned char>(buffer_[p - 1]));
+        if (state == CompiledDFA::DEAD) break;
+        if (openPrefixes_.isAccepting(state)) first = p - 1;
+    }
+    return first;
+}
+
+void StreamMatcher::reportEnding(size_t end) {
+    // Starts of matches ending here never precede the carry-over, since
+    // anything before it was not a match prefix when it was dropped
+    starts_.clear();
+    CompiledDFA::Index state = reverse_.getStartState();
+    if (reverse_.isAccepting(state)) starts_.push_back(end);
+    for (size_t p = end; p > 0; --p) {
+        state = reverse_.next(state, static_cast<unsigned char>(buffer_[p - 1]));
+        if (state == CompiledDFA::DEAD) break;
+        if (reverse_.isAccepting(state)) starts_.push_back(p - 1);
+    }
+    for (auto it = starts_.rbegin(); it != starts_.rend(); ++it) onMatch_(base_ + *it, base_ + end);
+}
+
+size_t StreamMatcher::reportLeftmost(size_t firstOpen) {
+    const size_t n = buffer_.size();
+    const auto* text = reinterpret_cast<const unsigned char*>(buffer_.data());
+
+    // Backward Σ*·reverse(L) pass finds every start of a match inside the
+    // buffer, in descending order
+    starts_.clear();
+    CompiledDFA::Index state = reverse_.getStartState();
+    if (scanner_) {
+        scanner_->findAccepting(buffer_.data(), n, true, starts_);
+    } else {
+        if (reverse_.isAccepting(state)) starts_.push_back(n);
+        for (size_t p = n; p > 0; --p) {
+            state = reverse_.next(state, text[p - 1]);
+            if (reverse_.isAccepting(state)) starts_.push_back(p - 1);
+        }
+    }
+
+    // A start before every open position cannot be preceded by a later
+    // match, and its anchored scan dies inside the buffer, so it is final
+    const bool longest = kind_ == MatchKind::LEFTMOST_LONGEST;
+    size_t pos = 0;
+    auto next = starts_.rbegin();
+    while (pos <= n) {
+        while (next != starts_.rend() && *next < pos) ++next;
+        if (next == starts_.rend() || *next >= firstOpen) break;
+        const size_t start = *next;
+
+        state = forward_.getStartState();
+        size_t end = start;
+        bool found = forward_.isAccepting(state);
+        if (!found || longest) {
+            for (size_t j = start; j < n; ++j) {
+                state = forward_.next(state, text[j]);
+                if (state == CompiledDFA::DEAD) break;
+                if (forward_.isAccepting(state)) {
+                    end = j + 1;
+                    found = true;
+                    if (!longest) break;
+                }
+            }
+        }
+
+        onMatch_(base_ + start, base_ + end);
+        pos = end > start ? end : start + 1;
+    }
+    return pos;
+}
+
+} // namespace automata
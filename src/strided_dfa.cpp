@@ -0,0 +1,142 @@
+#include "automata/strided_dfa.hpp"
+
+namespace automata {
+
+namespace {
+
+constexpr char BASES[] = "ACGT";
+
+} // namespace
+
+StridedDFA::StridedDFA() : stride_(1), shift_(2) {
+    codes_.fill(NOT_DNA);
+    for (uint8_t c = 0; c < 4; ++c) codes_[static_cast<unsigned char>(BASES[c])] = c;
+    table_.assign(4, 0);
+}
+
+bool StridedDFA::fits(const CompiledDFA& dfa, unsigned stride) {
+    for (int b = 0; b < 256; ++b) {
+        bool base = b == 'A' || b == 'C' || b == 'G' || b == 'T';
+        if (!base && dfa.getColumn(static_cast<unsigned char>(b)) != 0) return false;
+    }
+    return (dfa.getStateCount() << (2 * stride)) * sizeof(uint32_t) <= MAX_TABLE_BYTES;
+}
+
+StridedDFA StridedDFA::fromCompiled(const CompiledDFA& dfa, unsigned stride) {
+    if (stride != 1 && stride != 2 && stride != 4) {
+        throw std::invalid_argument("StridedDFA stride must be 1, 2 or 4");
+    }
+
+    StridedDFA result;
+    result.base_ = dfa;
+    result.stride_ = stride;
+    result.shift_ = 2 * stride;
+
+    const size_t words = size_t{1} << result.shift_;
+    result.table_.assign(dfa.getStateCount() << result.shift_, 0);
+    for (Index s = 0; s < dfa.getStateCount(); ++s) {
+        for (size_t w = 0; w < words; ++w) {
+            Index q = s;
+            uint32_t mask = 0;
+            for (unsigned i = 0; i < stride; ++i) {
+                unsigned code = (w >> (2 * (stride - 1 - i))) & 3;
+                q = dfa.next(q, static_cast<unsigned char>(BASES[code]));
+                if (dfa.isAccepting(q)) mask |= 1u << i;
+            }
+            result.table_[(static_cast<size_t>(s) << result.shift_) | w] = (q << 4) | mask;
+        }
+    }
+    return result;
+}
+
+StridedDFA StridedDFA::fromDFA(const DFA& dfa, unsigned stride) {
+    return fromCompiled(CompiledDFA::fromDFA(dfa), stride);
+}
+
+size_t StridedDFA::getMemoryUsage() const {
+    return sizeof(*this) - sizeof(base_) + base_.getMemoryUsage() + table_.size() * sizeof(uint32_t);
+}
+
+StridedDFA::Index StridedDFA::run(Index state, const char* data, size_t length) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    const uint32_t* table = table_.data();
+    const unsigned stride = stride_;
+    const unsigned shift = shift_;
+
+    size_t i = 0;
+    while (length - i >= stride) {
+        uint32_t word = 0;
+        uint8_t invalid = 0;
+        for (unsigned j = 0; j < stride; ++j) {
+            uint8_t code = codes_[bytes[i + j]];
+            invalid |= code;
+            word = (word << 2) | (code & 3);
+        }
+        if (invalid < 4) {
+            state = table[(static_cast<size_t>(state) << shift) | word] >> 4;
+            i += stride;
+        } else {
+            state = base_.next(state, bytes[i++]);
+        }
+        if (state == CompiledDFA::DEAD) return state;
+    }
+    for (; i < length; ++i) state = base_.next(state, bytes[i]);
+    return state;
+}
+
+bool StridedDFA::accepts(const std::string& input) const {
+    return accepts(input.data(), input.size());
+}
+
+bool StridedDFA::accepts(const char* data, size_t length) const {
+    return base_.isAccepting(run(base_.getStartState(), data, length));
+}
+
+void StridedDFA::findAccepting(const char* data, size_t length, bool backward, std::vector<size_t>& positions) const {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    if (backward) collectAccepting<true>(bytes, length, positions);
+    else collectAccepting<false>(bytes, length, positions);
+}
+
+// n counts bytes read so far; Backward reads data[length - 1 - n] and
+// reports offset length - n instead of data[n] and n
+template <bool Backward>
+void StridedDFA::collectAccepting(const unsigned char* bytes, size_t length, std::vector<size_t>& positions) const {
+    const uint32_t* table = table_.data();
+    const unsigned stride = stride_;
+    const unsigned shift = shift_;
+    auto byteAt = [bytes, length](size_t n) { return bytes[Backward ? length - 1 - n : n]; };
+    auto offset = [length](size_t n) { return Backward ? length - n : n; };
+
+    Index state = base_.getStartState();
+    if (base_.isAccepting(state)) positions.push_back(offset(0));
+
+    size_t n = 0;
+    while (length - n >= stride) {
+        uint32_t word = 0;
+        uint8_t invalid = 0;
+        for (unsigned j = 0; j < stride; ++j) {
+            uint8_t code = codes_[byteAt(n + j)];
+            invalid |= code;
+            word = (word << 2) | (code & 3);
+        }
+        if (invalid < 4) {
+            uint32_t entry = table[(static_cast<size_t>(state) << shift) | word];
+            for (uint32_t mask = entry & 15; mask != 0; mask &= mask - 1) {
+                positions.push_back(offset(n + 1 + static_cast<size_t>(__builtin_ctz(mask))));
+            }
+            state = entry >> 4;
+            n += stride;
+        } else {
+            state = base_.next(state, byteAt(n++));
+            if (base_.isAccepting(state)) positions.push_back(offset(n));
+        }
+        if (state == CompiledDFA::DEAD) return;
+    }
+    for (; n < length; ++n) {
+        state = base_.next(state, byteAt(n));
+        if (base_.isAccepting(state)) positions.push_back(offset(n + 1));
+    }
+}
+
+} // namespace automata
@@ -9,18 +9,53 @@ Transition::Transition(StateId from, StateId to, Symbol symbol)
     , symbol_(symbol)
 {}
 
+Transition::Transition(StateId from, StateId to, const SymbolSet& symbols)
+    : from_(from)
+    , to_(to)
+    , symbol_(EPSILON)
+    , symbols_(std::make_shared<const SymbolSet>(symbols))
+{
+    std::vector<Symbol> members = symbols.members();
+    if (members.empty()) {
+        throw AutomataException("Class transition needs at least one symbol");
+    }
+    symbol_ = members.front();
+}
+
+SymbolSet Transition::getSymbols() const {
+    if (symbols_) return *symbols_;
+    SymbolSet single;
+    single.add(symbol_);
+    return single;
+}
+
+Transition Transition::withEndpoints(StateId from, StateId to) const {
+    Transition result = *this;
+    result.from_ = from;
+    result.to_ = to;
+    return result;
+}
+
+std::string Transition::getLabel() const {
+    return symbols_ ? symbols_->toString() : symbolToString(symbol_);
+}
+
 bool Transition::operator<(const Transition& other) const {
     if (from_ != other.from_) return from_ < other.from_;
     if (symbol_ != other.symbol_) return symbol_ < other.symbol_;
-    return to_ < other.to_;
+    if (to_ != other.to_) return to_ < other.to_;
+    if (isClass() != other.isClass()) return !isClass();
+    return isClass() && *symbols_ < *other.symbols_;
 }
 
 bool Transition::operator==(const Transition& other) const {
-    return from_ == other.from_ && to_ == other.to_ && symbol_ == other.symbol_;
+    if (from_ != other.from_ || to_ != other.to_ || symbol_ != other.symbol_) return false;
+    if (isClass() != other.isClass()) return false;
+    return !isClass() || *symbols_ == *other.symbols_;
 }
 
 std::string Transition::toString() const {
-    return "(" + std::to_string(from_) + ", " + symbolToString(symbol_) + 
+    return "(" + std::to_string(from_) + ", " + getLabel() + 
            ") -> " + std::to_string(to_);
 }
 
@@ -28,8 +63,9 @@ std::string Transition::toJson() const {
     return JsonSerializer::ObjectBuilder()
         .add("from", from_)
         .add("to", to_)
-        .add("symbol", symbolToString(symbol_))
+        .add("symbol", getLabel())
         .add("isEpsilon", isEpsilon())
+        .add("isClass", isClass())
         .build();
 }
 
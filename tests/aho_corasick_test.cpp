@@ -0,0 +1,82 @@
+/**
+ * AhoCorasick against a naive search for every pattern of the panel
+ */
+
+#include "bio/aho_corasick.hpp"
+#include "test_support.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+using bio::AhoCorasick;
+
+namespace {
+
+// Every occurrence, ordered as findAll() documents: by end, longest first,
+// then by pattern index
+std::vector<AhoCorasick::Match> naiveFindAll(const std::vector<std::string>& patterns, const std::string& text) {
+    std::string upper = text;
+    for (auto& c : upper) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    std::vector<AhoCorasick::Match> matches;
+    for (size_t k = 0; k < patterns.size(); ++k) {
+        for (size_t p = upper.find(patterns[k]); p != std::string::npos; p = upper.find(patterns[k], p + 1)) {
+            matches.push_back({p, p + patterns[k].size(), k});
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const AhoCorasick::Match& a, const AhoCorasick::Match& b) {
+        if (a.end != b.end) return a.end < b.end;
+        if (a.start != b.start) return a.start < b.start;
+        return a.patternIndex < b.patternIndex;
+    });
+    return matches;
+}
+
+bool same(const std::vector<AhoCorasick::Match>& a, const std::vector<AhoCorasick::Match>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& x, const auto& y) {
+        return x.start == y.start && x.end == y.end && x.patternIndex == y.patternIndex;
+    });
+}
+
+void testRandomPanels(std::mt19937& rng) {
+    for (int panel = 0; panel < 50; ++panel) {
+        // Short patterns over few letters, so they nest, overlap and repeat
+        std::vector<std::string> patterns;
+        size_t count = 1 + rng() % 12;
+        for (size_t k = 0; k < count; ++k) {
+            patterns.push_back(test::randomString(rng, 1 + rng() % 6, "ACGT", panel % 2 ? 2 : 4));
+        }
+        if (panel % 5 == 0) patterns.push_back(patterns[0]);  // Duplicates are reported separately
+        AhoCorasick automaton(patterns);
+        for (int it = 0; it < 20; ++it) {
+            std::string text = test::randomString(rng, rng() % 300, "ACGTNacgt", it % 3 ? 4 : 9);
+            auto expected = naiveFindAll(patterns, text);
+            test::check(same(automaton.findAll(text), expected), "findAll of panel " + std::to_string(panel) + " on " + text);
+
+            std::vector<size_t> counts(patterns.size(), 0);
+            for (const auto& m : expected) ++counts[m.patternIndex];
+            test::check(automaton.countAll(text) == counts, "countAll of panel " + std::to_string(panel) + " on " + text);
+        }
+    }
+}
+
+void testInvalidPatterns() {
+    for (const std::vector<std::string> patterns : {std::vector<std::string>{""}, {"ACGT", "ACNT"}, {"AC-G"}}) {
+        bool threw = false;
+        try {
+            AhoCorasick automaton(patterns);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        test::check(threw, "invalid panel starting with '" + patterns[0] + "'");
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(16);
+    testRandomPanels(rng);
+    testInvalidPatterns();
+    return test::finish("aho_corasick_test");
+}
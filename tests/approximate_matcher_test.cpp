@@ -0,0 +1,73 @@
+/**
+ * ApproximateMatcher strategies against NFA simulation, on texts with
+ * planted near-occurrences of the pattern, and matches()/buildDFA()
+ * against the Levenshtein NFA
+ */
+
+#include "bio/approximate_matcher.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace bio;
+using Strategy = ApproximateMatcher::Strategy;
+
+namespace {
+
+bool sameMatches(const std::vector<ApproximateMatcher::Match>& x, const std::vector<ApproximateMatcher::Match>& y) {
+    if (x.size() != y.size()) return false;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (x[i].start != y[i].start || x[i].end != y[i].end || x[i].editDistance != y[i].editDistance ||
+            x[i].matchedText != y[i].matchedText) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testStrategies(std::mt19937& rng) {
+    for (int it = 0; it < 1500; ++it) {
+        // Patterns past 64 bases take the multi-word bit-vector path
+        size_t m = 1 + rng() % (it % 10 == 0 ? 150 : 12);
+        int k = static_cast<int>(rng() % 4);
+        std::string pattern = test::randomString(rng, m);
+        std::string text = test::randomString(rng, rng() % 250, "ACGTNacgt1", it % 3 ? 4 : 10);
+        for (int c = 0; c < 3 && text.size() > m + 5; ++c) {
+            std::string variant = test::mutate(pattern, static_cast<int>(rng() % (k + 2)), rng);
+            if (variant.size() < text.size()) {
+                text.replace(rng() % (text.size() - variant.size()), variant.size(), variant);
+            }
+        }
+
+        ApproximateMatcher nfa(pattern, k), bitVector(pattern, k), universal(pattern, k), seeded(pattern, k);
+        nfa.setStrategy(Strategy::NFA_SIMULATION);
+        bitVector.setStrategy(Strategy::BIT_VECTOR);
+        universal.setStrategy(Strategy::UNIVERSAL_AUTOMATON);
+        seeded.setStrategy(Strategy::SEED_AND_VERIFY);
+        auto expected = nfa.findAll(text);
+        std::string what = pattern + " k=" + std::to_string(k) + " on " + text;
+        test::check(sameMatches(bitVector.findAll(text), expected), "BIT_VECTOR " + what);
+        test::check(sameMatches(universal.findAll(text), expected), "UNIVERSAL_AUTOMATON " + what);
+        test::check(sameMatches(seeded.findAll(text), expected), "SEED_AND_VERIFY " + what);
+
+        // Acceptance: matches() and buildDFA() against the Levenshtein NFA,
+        // on a sample of the short patterns (the subset construction is slow)
+        if (m > 24 || it % 4) continue;
+        automata::NFA levenshtein = nfa.buildNFA();
+        automata::DFA dfa = universal.buildDFA();
+        for (int q = 0; q < 4; ++q) {
+            std::string input = q == 0 ? pattern : test::mutate(pattern, static_cast<int>(rng() % (k + 3)), rng);
+            bool accepted = levenshtein.accepts(input);
+            test::check(universal.matches(input) == accepted, "matches() " + what + " input " + input);
+            test::check(dfa.accepts(input) == accepted, "buildDFA() " + what + " input " + input);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(21);
+    testStrategies(rng);
+    return test::finish("approximate_matcher_test");
+}
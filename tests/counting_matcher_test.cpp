@@ -0,0 +1,90 @@
+/**
+ * CountingMatcher against the unrolled automaton, and the cost of large
+ * repetition bounds
+ */
+
+#include "automata/counting_matcher.hpp"
+#include "automata/dfa.hpp"
+#include "test_support.hpp"
+
+#include <chrono>
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "A{3,70}C", "(AC){2,5}", "(A|C){2,70}G", "A{0,100}", "(AC?){3,66}", "G(A*C){2,65}T", "T(CA|){1,70}",
+    "A{64}", "C{65,}G", "(A{2,3}C){4,6}",
+};
+
+const MatchKind KINDS[] = {MatchKind::LEFTMOST_LONGEST, MatchKind::LEFTMOST_SHORTEST, MatchKind::ALL_OVERLAPPING};
+
+void testAgainstUnrolled(std::mt19937& rng) {
+    CountingMatcher::Options options;
+    options.unrollLimit = 4;  // Count nearly every repetition
+    for (const auto& pattern : PATTERNS) {
+        CountingMatcher matcher(pattern, options);
+        test::check(matcher.getCounterCount() > 0, "counters in " + pattern);
+        RegexParser parser;
+        DFA dfa = DFA::fromNFA(parser.parse(pattern)).minimize();
+        for (int it = 0; it < 60; ++it) {
+            // Long runs of one letter reach the high counts
+            std::string text = test::randomString(rng, rng() % 300, "ACGT", it % 3 == 0 ? 2 : 4);
+            if (it % 4 == 0) text.insert(rng() % (text.size() + 1), std::string(rng() % 200, "AC"[it % 8 / 4]));
+            test::check(matcher.accepts(text) == dfa.accepts(text), "accepts " + pattern + " on " + text);
+            for (MatchKind kind : KINDS) {
+                test::check(matcher.findAll(text, kind) == dfa.findAllMatches(text, kind),
+                            pattern + " kind " + std::to_string(static_cast<int>(kind)) + " on " + text);
+            }
+        }
+    }
+}
+
+void testBounds() {
+    auto rejects = [](const std::string& pattern) {
+        try {
+            CountingMatcher matcher(pattern);
+        } catch (const ParseException&) {
+            return true;
+        }
+        return false;
+    };
+    const std::string max = std::to_string(CountingMatcher::MAX_COUNT);
+    const std::string over = std::to_string(CountingMatcher::MAX_COUNT + 1);
+    test::check(!rejects("C{" + max + "}"), "C{MAX_COUNT}");
+    test::check(rejects("C{" + over + "}"), "C{MAX_COUNT + 1}");
+    test::check(rejects("C{2," + over + "}"), "C{2,MAX_COUNT + 1}");
+    test::check(rejects("C{" + over + ",}"), "C{MAX_COUNT + 1,}");
+}
+
+double bestOfThree(const CountingMatcher& matcher, const std::string& text) {
+    double best = 1e9;
+    for (int run = 0; run < 3; ++run) {
+        auto begin = std::chrono::steady_clock::now();
+        matcher.findAll(text);
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+    }
+    return best;
+}
+
+void testLargeCountCost(std::mt19937& rng) {
+    // Short C runs only ever set the low counts: a bound of 2^16 must cost
+    // about as much as one of 129, not 2^16 / 64 words per step
+    std::string text = test::randomString(rng, 200000);
+    double small = bestOfThree(CountingMatcher("C{129}"), text);
+    double large = bestOfThree(CountingMatcher("C{" + std::to_string(CountingMatcher::MAX_COUNT) + "}"), text);
+    test::check(large < 5 * small + 0.01,
+                "C{MAX_COUNT} took " + std::to_string(large) + " s, C{129} " + std::to_string(small) + " s");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(13);
+    testAgainstUnrolled(rng);
+    testBounds();
+    testLargeCountCost(rng);
+    return test::finish("counting_matcher_test");
+}
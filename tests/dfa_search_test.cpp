@@ -0,0 +1,97 @@
+/**
+ * DFASearcher and DFA::findAllMatches against restarting the pattern DFA at
+ * every text position, for every match kind
+ */
+
+#include "automata/dfa_search.hpp"
+#include "automata/regex_parser.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+using Matches = std::vector<std::pair<size_t, size_t>>;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "", "GAATTC", "TATA[AT]A[AT]", "(TAA|TAG|TGA)", "A*", "AC*G", "(AC)+", "A|AC|ACGT", "[AG]CCATGG",
+    "G(A|C)*T", "C?", "AT(G|GA)*", "A|A[ACGT]*G", "(AA|A)*C?", "[ACGT]*T[ACGT]{2}", "(A(C|G)*T)*",
+    "(AC)*A?C*", "A{2,4}C",
+};
+
+const MatchKind KINDS[] = {MatchKind::LEFTMOST_LONGEST, MatchKind::LEFTMOST_SHORTEST, MatchKind::ALL_OVERLAPPING};
+
+Matches restartSearch(const CompiledDFA& dfa, const std::string& text, MatchKind kind) {
+    Matches matches;
+    size_t pos = 0;
+    for (size_t start = pos; start <= text.size(); ++start) {
+        if (start < pos) continue;
+        std::vector<size_t> ends;
+        CompiledDFA::Index state = dfa.getStartState();
+        if (dfa.isAccepting(state)) ends.push_back(start);
+        for (size_t j = start; j < text.size(); ++j) {
+            state = dfa.next(state, static_cast<unsigned char>(text[j]));
+            if (state == CompiledDFA::DEAD) break;
+            if (dfa.isAccepting(state)) ends.push_back(j + 1);
+        }
+        if (ends.empty()) continue;
+        if (kind == MatchKind::ALL_OVERLAPPING) {
+            for (size_t end : ends) matches.emplace_back(start, end);
+            continue;
+        }
+        size_t end = kind == MatchKind::LEFTMOST_LONGEST ? ends.back() : ends.front();
+        matches.emplace_back(start, end);
+        pos = end > start ? end : start + 1;
+    }
+    return matches;
+}
+
+void testAgainstRestart(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        RegexParser parser;
+        DFA dfa = DFA::fromNFA(parser.parse(pattern)).minimize();
+        for (MatchKind kind : KINDS) {
+            DFASearcher searcher = DFASearcher::fromPattern(pattern, kind);
+            for (int it = 0; it < 200; ++it) {
+                std::string text = test::randomString(rng, rng() % 121, "ACGT", it % 3 == 0 ? 2 : 4);
+                Matches expected = restartSearch(*dfa.getCompiled(), text, kind);
+                std::string what = pattern + " kind " + std::to_string(static_cast<int>(kind)) + " on " + text;
+                test::check(searcher.findAll(text) == expected, "DFASearcher " + what);
+                test::check(dfa.findAllMatches(text, kind) == expected, "DFA::findAllMatches " + what);
+            }
+        }
+    }
+}
+
+void testStateLimit(std::mt19937& rng) {
+    // Σ*·reverse(L) of [ACGT]{12}A needs 2^12 states; the limit must be enforced
+    DFASearcher::Options options;
+    options.maxStates = 1000;
+    bool threw = false;
+    try {
+        DFASearcher::fromPattern("[ACGT]{12}A", MatchKind::LEFTMOST_LONGEST, options);
+    } catch (const AutomataException&) {
+        threw = true;
+    }
+    test::check(threw, "DFASearcher::Options::maxStates");
+
+    // findAllMatches falls back to restarting when the searcher is too large
+    RegexParser parser;
+    DFA dfa = DFA::fromNFA(parser.parse("[ACGT]{17}A")).minimize();
+    for (int it = 0; it < 20; ++it) {
+        std::string text = test::randomString(rng, rng() % 200);
+        test::check(dfa.findAllMatches(text, MatchKind::LEFTMOST_LONGEST) ==
+                        restartSearch(*dfa.getCompiled(), text, MatchKind::LEFTMOST_LONGEST),
+                    "findAllMatches restart fallback on " + text);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(11);
+    testAgainstRestart(rng);
+    testStateLimit(rng);
+    return test::finish("dfa_search_test");
+}
@@ -0,0 +1,87 @@
+/**
+ * EditDistance kernels against textbook dynamic programming: every
+ * backend, the banded bound, and both alignment paths
+ */
+
+#include "bio/approximate_matcher.hpp"
+#include "bio/edit_distance.hpp"
+#include "test_support.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace bio;
+using Backend = EditDistance::Backend;
+
+namespace {
+
+int referenceDistance(const std::string& a, const std::string& b) {
+    std::vector<std::vector<int>> dp(a.size() + 1, std::vector<int>(b.size() + 1));
+    for (size_t i = 0; i <= a.size(); ++i) dp[i][0] = static_cast<int>(i);
+    for (size_t j = 0; j <= b.size(); ++j) dp[0][j] = static_cast<int>(j);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        for (size_t j = 1; j <= b.size(); ++j) {
+            dp[i][j] = a[i - 1] == b[j - 1] ? dp[i - 1][j - 1]
+                                            : 1 + std::min({dp[i - 1][j], dp[i][j - 1], dp[i - 1][j - 1]});
+        }
+    }
+    return dp[a.size()][b.size()];
+}
+
+void testDistance(std::mt19937& rng) {
+    using EditOperation = ApproximateMatcher::EditOperation;
+    for (int it = 0; it < 1500; ++it) {
+        std::string a = test::randomString(rng, rng() % (it % 10 ? 50 : 400));
+        std::string b = it % 7 == 0 ? test::randomString(rng, rng() % 300)
+                                    : test::mutate(a, static_cast<int>(rng() % (a.size() / 3 + 3)), rng);
+        int distance = referenceDistance(a, b);
+        std::string what = a + " / " + b;
+        for (Backend backend : {Backend::SCALAR, Backend::SSE41, Backend::AVX2}) {
+            test::check(EditDistance::distance(a.data(), a.size(), b.data(), b.size(), backend) == distance,
+                        "distance backend " + std::to_string(static_cast<int>(backend)) + " " + what);
+        }
+        for (int k = 0; k < 6; ++k) {
+            test::check(EditDistance::bounded(a, b, k) == std::min(distance, k + 1),
+                        "bounded k=" + std::to_string(k) + " " + what);
+        }
+
+        // Replaying the operations on a must give b at the same cost
+        int cost = 0;
+        std::string replay;
+        for (const auto& op : ApproximateMatcher::getEditOperations(a, b)) {
+            if (op.type != EditOperation::MATCH) ++cost;
+            if (op.type != EditOperation::DELETE) replay += op.character;
+        }
+        test::check(cost == distance && replay == b, "getEditOperations " + what);
+    }
+}
+
+void testLongAlignment(std::mt19937& rng) {
+    // Past 2^20 cells alignment() switches to the linear-space path
+    for (int it = 0; it < 3; ++it) {
+        std::string a = test::randomString(rng, 3000 + rng() % 3000);
+        std::string b = test::mutate(a, static_cast<int>(rng() % 1000), rng);
+        int cost = 0;
+        size_t i = 0, j = 0;
+        bool consistent = true;
+        for (auto op : EditDistance::alignment(a, b)) {
+            switch (op) {
+                case EditDistance::Op::MATCH: consistent &= i < a.size() && j < b.size() && a[i++] == b[j++]; break;
+                case EditDistance::Op::SUBSTITUTE: ++cost; ++i; ++j; break;
+                case EditDistance::Op::INSERT: ++cost; ++j; break;
+                default: ++cost; ++i; break;
+            }
+        }
+        test::check(consistent && i == a.size() && j == b.size() && cost == EditDistance::distance(a, b),
+                    "alignment of " + std::to_string(a.size()) + " and " + std::to_string(b.size()) + " bases");
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(23);
+    testDistance(rng);
+    testLongAlignment(rng);
+    return test::finish("edit_distance_test");
+}
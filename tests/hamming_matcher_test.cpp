@@ -0,0 +1,68 @@
+/**
+ * HammingMatcher backends against a naive k-mismatch scan, and
+ * DNAApproximateMatcher::findInSequence against findAll
+ */
+
+#include "bio/approximate_matcher.hpp"
+#include "bio/hamming_matcher.hpp"
+#include "bio/sequence.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace bio;
+using Backend = HammingMatcher::Backend;
+
+namespace {
+
+void testBackends(std::mt19937& rng) {
+    for (int it = 0; it < 1500; ++it) {
+        // Patterns past 64 bases need more than one word
+        size_t m = 1 + rng() % (it % 10 ? 20 : 150);
+        int k = static_cast<int>(rng() % 6) - 1;
+        std::string pattern = test::randomString(rng, m, "ACGTN", it % 4 ? 4 : 5);
+        std::string text = test::randomString(rng, rng() % (it % 5 ? 700 : 3000), "ACGTNa", it % 3 ? 4 : 6);
+        for (int c = 0; c < 5 && text.size() >= m; ++c) text.replace(rng() % (text.size() - m + 1), m, pattern);
+
+        std::vector<std::pair<size_t, int>> expected;
+        for (size_t s = 0; k >= 0 && s + m <= text.size(); ++s) {
+            int mismatches = 0;
+            for (size_t j = 0; j < m; ++j) mismatches += text[s + j] != pattern[j];
+            if (mismatches <= k) expected.emplace_back(s, mismatches);
+        }
+        for (Backend backend : {Backend::SCALAR, Backend::AVX2}) {
+            HammingMatcher matcher(pattern, k);
+            matcher.setBackend(backend);
+            std::vector<std::pair<size_t, int>> got;
+            for (const auto& hit : matcher.findAll(text)) got.emplace_back(hit.start, hit.mismatches);
+            test::check(got == expected, pattern + " k=" + std::to_string(k) + " backend " +
+                                             std::to_string(static_cast<int>(backend)) + " on " + text);
+        }
+    }
+}
+
+void testFindInSequence(std::mt19937& rng) {
+    for (int it = 0; it < 300; ++it) {
+        int k = static_cast<int>(rng() % 4);
+        std::string pattern = test::randomString(rng, 1 + rng() % 12);
+        Sequence sequence(test::randomString(rng, rng() % 300), SequenceType::DNA);
+        DNAApproximateMatcher matcher(pattern, k);
+        auto got = matcher.findInSequence(sequence);
+        auto expected = matcher.findAll(sequence.getString());
+        bool same = got.size() == expected.size();
+        for (size_t i = 0; same && i < got.size(); ++i) {
+            same = got[i].start == expected[i].start && got[i].end == expected[i].end &&
+                   got[i].editDistance == expected[i].editDistance && got[i].matchedText == expected[i].matchedText;
+        }
+        test::check(same, "findInSequence " + pattern + " k=" + std::to_string(k) + " on " + sequence.getString());
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(24);
+    testBackends(rng);
+    testFindInSequence(rng);
+    return test::finish("hamming_matcher_test");
+}
@@ -0,0 +1,95 @@
+/**
+ * KmerIndex lookups against a naive scan, and index-seeded approximate
+ * search against NFA simulation
+ */
+
+#include "bio/approximate_matcher.hpp"
+#include "bio/kmer_index.hpp"
+#include "test_support.hpp"
+
+#include <cctype>
+#include <vector>
+
+using namespace bio;
+
+namespace {
+
+// Start positions of kmer in reference, case-insensitively
+std::vector<uint32_t> naiveLookup(const std::string& reference, const std::string& kmer) {
+    std::vector<uint32_t> positions;
+    for (size_t p = 0; p + kmer.size() <= reference.size(); ++p) {
+        bool same = true;
+        for (size_t j = 0; j < kmer.size() && same; ++j) {
+            same = std::toupper(static_cast<unsigned char>(reference[p + j])) == kmer[j];
+        }
+        if (same) positions.push_back(static_cast<uint32_t>(p));
+    }
+    return positions;
+}
+
+void testLookup(std::mt19937& rng) {
+    for (int it = 0; it < 200; ++it) {
+        int k = 1 + static_cast<int>(rng() % 8);
+        std::string reference = test::randomString(rng, rng() % 2000, "ACGTacgtN", it % 2 ? 4 : 9);
+        KmerIndex index(reference, k);
+        for (int q = 0; q < 20; ++q) {
+            // Mostly k-mers that occur, some with N (never indexed)
+            std::string kmer = reference.size() >= static_cast<size_t>(k) && q % 4
+                                   ? reference.substr(rng() % (reference.size() - k + 1), k)
+                                   : test::randomString(rng, k, "ACGTN", q % 8 ? 4 : 5);
+            for (auto& c : kmer) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            auto [begin, end] = index.lookup(kmer.data());
+            std::vector<uint32_t> got(begin, end);
+            std::vector<uint32_t> expected = kmer.find('N') == std::string::npos ? naiveLookup(reference, kmer)
+                                                                                 : std::vector<uint32_t>();
+            test::check(got == expected, "lookup " + kmer + " k=" + std::to_string(k));
+        }
+    }
+
+    for (int k : {0, KmerIndex::MAX_K + 1}) {
+        bool threw = false;
+        try {
+            KmerIndex index("ACGT", k);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        test::check(threw, "KmerIndex with k=" + std::to_string(k));
+    }
+}
+
+void testSeededSearch(std::mt19937& rng) {
+    for (int it = 0; it < 500; ++it) {
+        size_t m = 1 + rng() % (it % 10 == 0 ? 60 : 16);
+        int k = static_cast<int>(rng() % 4);
+        std::string pattern = test::randomString(rng, m);
+        std::string text = test::randomString(rng, rng() % 400, "ACGTNacgt", it % 3 ? 4 : 9);
+        for (int c = 0; c < 3 && text.size() > m + 5; ++c) {
+            std::string variant = test::mutate(pattern, static_cast<int>(rng() % (k + 2)), rng);
+            if (variant.size() < text.size()) {
+                text.replace(rng() % (text.size() - variant.size()), variant.size(), variant);
+            }
+        }
+
+        ApproximateMatcher nfa(pattern, k), seeded(pattern, k);
+        nfa.setStrategy(ApproximateMatcher::Strategy::NFA_SIMULATION);
+        auto expected = nfa.findAll(text);
+        KmerIndex index(text, 1 + static_cast<int>(rng() % 6));
+        auto got = seeded.findAll(text, index);
+        bool same = got.size() == expected.size();
+        for (size_t i = 0; same && i < got.size(); ++i) {
+            same = got[i].start == expected[i].start && got[i].end == expected[i].end &&
+                   got[i].editDistance == expected[i].editDistance && got[i].matchedText == expected[i].matchedText;
+        }
+        test::check(same, "findAll(text, index) " + pattern + " k=" + std::to_string(k) + " index k=" +
+                              std::to_string(index.getK()) + " on " + text);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(25);
+    testLookup(rng);
+    testSeededSearch(rng);
+    return test::finish("kmer_index_test");
+}
@@ -0,0 +1,67 @@
+/**
+ * LazyDFA against DFASearcher for every match kind, with the default cache
+ * and with caches small enough to flush mid-scan
+ */
+
+#include "automata/dfa_search.hpp"
+#include "automata/lazy_dfa.hpp"
+#include "automata/regex_parser.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "", "GAATTC", "(TAA|TAG|TGA)", "A*", "(AC)+", "A|AC|ACGT", "G(A|C)*T", "C?", "A|A[ACGT]*G",
+    "(AA|A)*C?", "[ACGT]*T[ACGT]{2}", "(A(C|G)*T)*", "A{2,4}C", "A[ACGT]{5}T",
+};
+
+const MatchKind KINDS[] = {MatchKind::LEFTMOST_LONGEST, MatchKind::LEFTMOST_SHORTEST, MatchKind::ALL_OVERLAPPING};
+
+void testAgainstSearcher(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        RegexParser parser;
+        NFA nfa = parser.parse(pattern);
+        LazyDFA::Options tiny;
+        tiny.maxCacheBytes = 600;
+        tiny.maxFlushes = 3;
+        for (MatchKind kind : KINDS) {
+            DFASearcher searcher = DFASearcher::fromPattern(pattern, kind);
+            LazyDFA lazy(nfa);
+            LazyDFA flushing(nfa, tiny);
+            for (int it = 0; it < 100; ++it) {
+                std::string text = test::randomString(rng, rng() % 300, "ACGT", it % 3 == 0 ? 2 : 4);
+                std::vector<LazyDFA::Match> expected = searcher.findAll(text);
+                std::string what = pattern + " kind " + std::to_string(static_cast<int>(kind)) + " on " + text;
+                test::check(lazy.findAll(text, kind) == expected, "LazyDFA " + what);
+                test::check(flushing.findAll(text, kind) == expected, "LazyDFA with a small cache " + what);
+            }
+        }
+    }
+}
+
+void testFullCacheAtScanStart(std::mt19937& rng) {
+    // Each scan leaves its cache full; the next one must flush rather than
+    // give up on caching before reading a byte
+    RegexParser parser;
+    LazyDFA::Options options;
+    options.maxCacheBytes = 2000;
+    options.maxFlushes = 1000000;
+    LazyDFA lazy(parser.parse("[ACGT]*A[ACGT]{6}"), options);
+    for (int it = 0; it < 20; ++it) lazy.accepts(test::randomString(rng, 2000));
+    test::check(lazy.getStats().cacheFlushes > 0, "a 2000-byte cache flushes");
+    test::check(lazy.getStats().nfaFallbacks == 0,
+                "NFA fallbacks with unlimited flushes: " + std::to_string(lazy.getStats().nfaFallbacks));
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(8);
+    testAgainstSearcher(rng);
+    testFullCacheAtScanStart(rng);
+    return test::finish("lazy_dfa_test");
+}
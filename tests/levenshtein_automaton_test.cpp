@@ -0,0 +1,57 @@
+/**
+ * LevenshteinDFA against textbook dynamic programming, for every k the
+ * universal automata support
+ */
+
+#include "bio/levenshtein_automaton.hpp"
+#include "test_support.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace bio;
+
+namespace {
+
+int referenceDistance(const std::string& a, const std::string& b) {
+    std::vector<std::vector<int>> dp(a.size() + 1, std::vector<int>(b.size() + 1));
+    for (size_t i = 0; i <= a.size(); ++i) dp[i][0] = static_cast<int>(i);
+    for (size_t j = 0; j <= b.size(); ++j) dp[0][j] = static_cast<int>(j);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        for (size_t j = 1; j <= b.size(); ++j) {
+            dp[i][j] = a[i - 1] == b[j - 1] ? dp[i - 1][j - 1]
+                                            : 1 + std::min({dp[i - 1][j], dp[i][j - 1], dp[i - 1][j - 1]});
+        }
+    }
+    return dp[a.size()][b.size()];
+}
+
+void testDistance(std::mt19937& rng) {
+    for (int it = 0; it < 20000; ++it) {
+        int k = static_cast<int>(rng() % 4);
+        std::string pattern = test::randomString(rng, rng() % (it % 50 == 0 ? 150 : 10));
+        std::string text = it % 3 == 0 ? test::randomString(rng, rng() % (pattern.size() + 5))
+                                       : test::mutate(pattern, static_cast<int>(rng() % 5), rng);
+        LevenshteinDFA dfa(pattern, k);
+        auto cursor = dfa.start();
+        for (char c : text) {
+            cursor = dfa.next(cursor, c);
+            if (dfa.isDead(cursor)) break;
+        }
+        // Distances above k are all reported as k + 1
+        int got = dfa.isDead(cursor) ? k + 1 : dfa.distance(cursor);
+        int expected = std::min(referenceDistance(pattern, text), k + 1);
+        test::check(got == expected, pattern + " k=" + std::to_string(k) + " on " + text + ": " +
+                                         std::to_string(got) + " instead of " + std::to_string(expected));
+        test::check(dfa.isDead(cursor) || dfa.isAccepting(cursor) == (expected <= k),
+                    "isAccepting " + pattern + " on " + text);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(22);
+    testDistance(rng);
+    return test::finish("levenshtein_automaton_test");
+}
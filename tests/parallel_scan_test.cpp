@@ -0,0 +1,68 @@
+/**
+ * ParallelScanner against a single-threaded scan, with chunks small enough
+ * that matches and lookback windows straddle chunk boundaries
+ */
+
+#include "automata/parallel_scan.hpp"
+#include "automata/regex_parser.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "GAATTC", "(AC)+", "A|AC|ACGT", "G(A|C)*T", "[ACGT]*GG[ACGT]*", "(A|C)*", "T{3,5}",
+};
+
+void testAgainstSingleThread(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        RegexParser parser;
+        DFA dfa = DFA::fromNFA(parser.parse(pattern)).minimize();
+        const CompiledDFA& compiled = *dfa.getCompiled();
+        for (bool speculate : {false, true}) {
+            ParallelScanner::Options options;
+            options.threads = 4;
+            options.minChunkSize = 1 + rng() % 16;
+            options.speculate = speculate;
+            options.lookback = rng() % 8;
+            ParallelScanner scanner(dfa, options);
+            for (int it = 0; it < 100; ++it) {
+                std::string text = test::randomString(rng, rng() % 200, "ACGT", it % 2 ? 4 : 2);
+                std::string what = pattern + (speculate ? " speculating" : "") + " on " + text;
+                test::check(scanner.accepts(text) == compiled.accepts(text), "accepts " + what);
+                test::check(scanner.findAllMatches(text) == dfa.findAllMatches(text, MatchKind::ALL_OVERLAPPING),
+                            "findAllMatches " + what);
+            }
+        }
+    }
+}
+
+void testLargeOverlappingSearcher(std::mt19937& rng) {
+    // Σ*L of this pattern exceeds the searcher's state limit; accepts() must not need it
+    RegexParser parser;
+    DFA dfa = DFA::fromNFA(parser.parse("AAC[ACGT]{0,30}GGT")).minimize();
+    ParallelScanner::Options options;
+    options.threads = 4;
+    options.minChunkSize = 8;
+    try {
+        ParallelScanner scanner(dfa, options);
+        for (int it = 0; it < 50; ++it) {
+            std::string text = "AAC" + test::randomString(rng, rng() % 40) + (it % 2 ? "GGT" : "");
+            test::check(scanner.accepts(text) == dfa.accepts(text), "accepts with a large Σ*L on " + text);
+        }
+    } catch (const AutomataException& e) {
+        test::check(false, std::string("ParallelScanner threw: ") + e.what());
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(5);
+    testAgainstSingleThread(rng);
+    testLargeOverlappingSearcher(rng);
+    return test::finish("parallel_scan_test");
+}
@@ -0,0 +1,101 @@
+/**
+ * PatternCache: LRU eviction order, hit and miss counters, capacity 0 and
+ * compiler failures, with a stub compiler that records its calls
+ */
+
+#include "api/pattern_cache.hpp"
+#include "test_support.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace api;
+
+namespace {
+
+struct Recorder {
+    std::vector<std::string> compiled;
+
+    PatternCache::Compiler compiler() {
+        return [this](const PatternKey& key) {
+            if (key.pattern == "BAD") throw std::invalid_argument("bad pattern");
+            compiled.push_back(key.pattern);
+            auto result = std::make_shared<CompiledPattern>();
+            result->pattern = key.pattern;
+            return std::shared_ptr<const CompiledPattern>(result);
+        };
+    }
+};
+
+PatternKey key(const std::string& pattern, int maxDistance = 0) {
+    PatternKey k;
+    k.pattern = pattern;
+    k.maxDistance = maxDistance;
+    return k;
+}
+
+void testEvictionOrder() {
+    Recorder recorder;
+    PatternCache cache(2, recorder.compiler());
+    auto a = cache.get(key("A"));
+    cache.get(key("C"));
+    test::check(cache.get(key("A")) == a, "hit returns the cached entry");  // A is now most recent
+    cache.get(key("G"));                                                   // Evicts C, the least recent
+    test::check(cache.size() == 2, "size at capacity");
+    cache.get(key("A"));
+    cache.get(key("G"));
+    test::check(recorder.compiled == std::vector<std::string>({"A", "C", "G"}), "A and G stay cached");
+    cache.get(key("C"));
+    test::check(recorder.compiled.back() == "C", "C was evicted");
+    test::check(cache.getHits() == 3 && cache.getMisses() == 4,
+                "hits " + std::to_string(cache.getHits()) + " misses " + std::to_string(cache.getMisses()));
+
+    // Every field of the key counts
+    cache.get(key("C", 1));
+    test::check(cache.getMisses() == 5, "maxDistance is part of the key");
+
+    cache.clear();
+    test::check(cache.size() == 0 && cache.getHits() == 0 && cache.getMisses() == 0, "clear");
+}
+
+void testWarmUp() {
+    Recorder recorder;
+    PatternCache cache(4, recorder.compiler());
+    cache.warmUp(key("GAATTC"));
+    test::check(cache.getHits() == 0 && cache.getMisses() == 0, "warmUp is not counted");
+    cache.get(key("GAATTC"));
+    test::check(cache.getHits() == 1 && recorder.compiled.size() == 1, "warmed-up entry is a hit");
+}
+
+void testCapacityZero() {
+    Recorder recorder;
+    PatternCache cache(0, recorder.compiler());
+    for (int i = 0; i < 3; ++i) test::check(cache.get(key("A"))->pattern == "A", "result with capacity 0");
+    test::check(recorder.compiled.size() == 3, "capacity 0 compiles every time");
+    test::check(cache.size() == 0 && cache.getHits() == 0 && cache.getMisses() == 3, "capacity 0 counters");
+}
+
+void testCompilerFailure() {
+    Recorder recorder;
+    PatternCache cache(4, recorder.compiler());
+    for (int i = 0; i < 2; ++i) {
+        bool threw = false;
+        try {
+            cache.get(key("BAD"));
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        test::check(threw, "compiler exception propagates");
+    }
+    test::check(cache.size() == 0 && cache.getMisses() == 2, "failures are not cached");
+}
+
+} // namespace
+
+int main() {
+    testEvictionOrder();
+    testWarmUp();
+    testCapacityZero();
+    testCompilerFailure();
+    return test::finish("pattern_cache_test");
+}
@@ -0,0 +1,76 @@
+/**
+ * LiteralPrefilter: DFASearcher finds the same matches with and without
+ * it, and every backend finds the literal where std::string::find does
+ */
+
+#include "automata/dfa_search.hpp"
+#include "automata/prefilter.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+using Backend = LiteralPrefilter::Backend;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "GAATTC", "[ACGT]{3}GAATTC[AG]", "TATA[AT]A[AT]GGG", "(A|C){0,4}ACGT(T|G)?", "GGATCC|GGATCCA", "A?CCCGGG[ACGT]{0,8}",
+};
+
+const MatchKind KINDS[] = {MatchKind::LEFTMOST_LONGEST, MatchKind::LEFTMOST_SHORTEST, MatchKind::ALL_OVERLAPPING};
+
+// Random DNA with occurrences of the literal planted at a given rate
+std::string plantedText(std::mt19937& rng, const std::string& literal, size_t length, size_t every) {
+    std::string text = test::randomString(rng, length);
+    for (size_t i = 0; i + literal.size() <= text.size(); i += 1 + rng() % every) {
+        text.replace(i, literal.size(), literal);
+    }
+    return text;
+}
+
+void testSearchWithAndWithout(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        for (MatchKind kind : KINDS) {
+            DFASearcher filtered = DFASearcher::fromPattern(pattern, kind);
+            DFASearcher plain = DFASearcher::fromPattern(pattern, kind);
+            test::check(filtered.getPrefilter().has_value(), "prefilter for " + pattern);
+            if (!filtered.getPrefilter()) continue;
+            plain.setPrefilter(std::nullopt);
+            const std::string literal = filtered.getPrefilter()->getLiteral();
+            for (int it = 0; it < 40; ++it) {
+                // From a few occurrences (regions searched) to dense ones (full scan)
+                size_t every = it % 2 ? 2000 : 3 + rng() % 60;
+                std::string text = plantedText(rng, literal, rng() % 5000, every);
+                std::string what = pattern + " kind " + std::to_string(static_cast<int>(kind)) + " length " +
+                                   std::to_string(text.size());
+                test::check(filtered.findAll(text) == plain.findAll(text), what);
+            }
+        }
+    }
+}
+
+void testFind(std::mt19937& rng) {
+    for (const std::string literal : {"GAATTC", "AAA", "ACGTACGTACGTACGTACGTACGTACGTACGTACG"}) {
+        LiteralPrefilter prefilter(literal, literal.size());
+        for (int it = 0; it < 100; ++it) {
+            std::string text = plantedText(rng, literal, rng() % 300, 100);
+            size_t from = text.empty() ? 0 : rng() % text.size();
+            for (Backend backend : {Backend::SCALAR, Backend::SSE2, Backend::AVX2}) {
+                prefilter.setBackend(backend);
+                size_t expected = text.find(literal, from);
+                test::check(prefilter.find(text.data(), text.size(), from) == expected,
+                            "find " + literal + " backend " + std::to_string(static_cast<int>(backend)) + " in " + text);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(15);
+    testSearchWithAndWithout(rng);
+    testFind(rng);
+    return test::finish("prefilter_test");
+}
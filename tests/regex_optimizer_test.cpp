@@ -0,0 +1,68 @@
+/**
+ * RegexOptimizer rewrites: the optimized tree has the expected shape and
+ * the same language as the parsed one
+ */
+
+#include "automata/dfa.hpp"
+#include "automata/regex_optimizer.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+// Pattern, then RegexParser::ASTNode::toString() of its optimized tree
+const std::vector<std::pair<std::string, std::string>> REWRITES = {
+    {"TAA|TAG|TGA", "T(A[AG]|GA)"},
+    {"A|C|G", "[ACG]"},
+    {"AC|GC", "[AG]C"},
+    {"((AC))", "AC"},
+    {"A|", "(A)?"},
+    {"(A*)*", "(A)*"},
+};
+
+const std::vector<std::string> PATTERNS = {
+    "TAA|TAG|TGA", "A|C|G|A", "AC|GC|TC", "(A*)*", "(A?)*", "(A+)*", "(A*)?", "(A+)+", "A||C", "(AC|AG)T|ACT",
+    "GAATTC|GGATCC|AAGCTT", "(A|AC)(C|)", "((A|C)|(G|T))*", "[AC]|A|.", "ACGT|ACG|AC|A|",
+};
+
+NFA parse(const std::string& pattern, bool optimize) {
+    RegexParser parser;
+    parser.setOptimize(optimize);
+    return parser.parse(pattern);
+}
+
+void testRewrites() {
+    for (const auto& [pattern, expected] : REWRITES) {
+        RegexParser parser;
+        std::string got = RegexOptimizer::optimize(parser.parseAST(pattern))->toString();
+        test::check(got == expected, pattern + " optimized to " + got + ", expected " + expected);
+    }
+}
+
+void testLanguage(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        NFA plain = parse(pattern, false);
+        NFA optimized = parse(pattern, true);
+        DFA plainDfa = DFA::fromNFA(plain).minimize();
+        DFA optimizedDfa = DFA::fromNFA(optimized).minimize();
+        // Minimal DFAs of one language have the same size
+        test::check(plainDfa.getStateCount() == optimizedDfa.getStateCount(), "minimal DFA size of " + pattern);
+        test::check(optimized.getStateCount() <= plain.getStateCount(), "NFA size of " + pattern);
+        for (int it = 0; it < 300; ++it) {
+            std::string text = test::randomString(rng, rng() % 7, "ACGTN", 5);
+            test::check(plainDfa.accepts(text) == optimizedDfa.accepts(text), pattern + " on " + text);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(14);
+    testRewrites();
+    testLanguage(rng);
+    return test::finish("regex_optimizer_test");
+}
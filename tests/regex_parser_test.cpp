@@ -0,0 +1,68 @@
+/**
+ * RegexParser counted repetition: accepted languages and rejected bounds
+ */
+
+#include "automata/regex_parser.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+bool rejects(const std::string& pattern) {
+    try {
+        RegexParser parser;
+        parser.parseAST(pattern);
+    } catch (const ParseException&) {
+        return true;
+    }
+    return false;
+}
+
+void testLanguages() {
+    struct Case {
+        std::string pattern;
+        std::vector<std::string> accepted;
+        std::vector<std::string> rejected;
+    };
+    const std::vector<Case> cases = {
+        {"A{3}", {"AAA"}, {"", "AA", "AAAA"}},
+        {"A{2,3}", {"AA", "AAA"}, {"A", "AAAA"}},
+        {"A{2,}", {"AA", "AAAAAA"}, {"", "A"}},
+        {"(AC){0,2}G", {"G", "ACG", "ACACG"}, {"ACACACG", "AG"}},
+        {"A{0}C", {"C"}, {"AC"}},
+        {"A{2,2}", {"AA"}, {"A", "AAA"}},
+    };
+    for (const auto& c : cases) {
+        RegexParser parser;
+        NFA nfa = parser.parse(c.pattern);
+        for (const auto& s : c.accepted) test::check(nfa.accepts(s), c.pattern + " accepts '" + s + "'");
+        for (const auto& s : c.rejected) test::check(!nfa.accepts(s), c.pattern + " rejects '" + s + "'");
+    }
+}
+
+void testBounds() {
+    const std::string max = std::to_string(RegexParser::MAX_REPEAT);
+    const std::string over = std::to_string(RegexParser::MAX_REPEAT + 1);
+    test::check(!rejects("A{" + max + "}"), "A{MAX_REPEAT}");
+    test::check(!rejects("A{1," + max + "}"), "A{1,MAX_REPEAT}");
+    test::check(rejects("A{" + over + "}"), "A{MAX_REPEAT + 1}");
+    test::check(rejects("A{" + over + ",}"), "A{MAX_REPEAT + 1,}");
+    test::check(rejects("A{0," + over + "}"), "A{0,MAX_REPEAT + 1}");
+    test::check(rejects("A{3,2}"), "A{3,2}");
+    test::check(!rejects("A{2,2}"), "A{2,2}");
+    // Would overflow int while parsing
+    test::check(rejects("A{99999999999}"), "A{99999999999}");
+    test::check(rejects("A{2147483648}"), "A{2147483648}");
+    test::check(rejects("A{1,99999999999999999999}"), "A{1,99999999999999999999}");
+}
+
+} // namespace
+
+int main() {
+    testLanguages();
+    testBounds();
+    return test::finish("regex_parser_test");
+}
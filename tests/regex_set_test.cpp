@@ -0,0 +1,80 @@
+/**
+ * RegexSet against one DFASearcher per pattern, with overlapping patterns
+ * and patterns that match the empty string
+ */
+
+#include "automata/dfa_search.hpp"
+#include "automata/regex_set.hpp"
+#include "test_support.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+const std::vector<std::vector<std::string>> SETS = {
+    {"GAATTC", "GGATCC", "AAGCTT"},
+    {"A", "AA", "A+", "AAC"},                   // Overlapping and nested
+    {"A*", "C?", "(AC)*"},                      // Empty matches everywhere
+    {"TATA[AT]A[AT]", "[ACGT]{2}T", "G(A|C)*T", ""},
+    {"A|AC|ACGT", "AC|ACGT", "ACGT"},
+    {"(TAA|TAG|TGA)", "ATG([ACGT]{3})*"},
+};
+
+void testAgainstSearchers(std::mt19937& rng) {
+    for (const auto& patterns : SETS) {
+        RegexSet set(patterns);
+        std::vector<DFASearcher> searchers;
+        for (const auto& pattern : patterns) {
+            searchers.push_back(DFASearcher::fromPattern(pattern, MatchKind::ALL_OVERLAPPING));
+        }
+        const std::string name = "set starting with '" + patterns[0] + "'";
+
+        for (int it = 0; it < 100; ++it) {
+            std::string text = test::randomString(rng, rng() % 150, "ACGTN", it % 3 == 0 ? 2 : (it % 5 ? 4 : 5));
+            std::vector<RegexSet::Match> expected;
+            std::vector<size_t> matching;
+            for (size_t k = 0; k < patterns.size(); ++k) {
+                auto found = searchers[k].findAll(text);
+                if (!found.empty()) matching.push_back(k);
+                for (const auto& [start, end] : found) expected.push_back({k, start, end});
+            }
+            std::sort(expected.begin(), expected.end(), [](const RegexSet::Match& a, const RegexSet::Match& b) {
+                return std::tie(a.start, a.end, a.pattern) < std::tie(b.start, b.end, b.pattern);
+            });
+
+            auto got = set.findAll(text);
+            bool same = std::equal(got.begin(), got.end(), expected.begin(), expected.end(),
+                                   [](const auto& a, const auto& b) {
+                                       return a.pattern == b.pattern && a.start == b.start && a.end == b.end;
+                                   });
+            test::check(same, "findAll of " + name + " on " + text);
+            test::check(set.matches(text) == matching, "matches of " + name + " on " + text);
+            test::check(set.isMatch(text) == !matching.empty(), "isMatch of " + name + " on " + text);
+        }
+    }
+}
+
+void testStateLimit() {
+    RegexSet::Options options;
+    options.maxStates = 16;
+    bool threw = false;
+    try {
+        RegexSet set({"A[ACGT]{4}", "C[ACGT]{4}"}, options);
+    } catch (const AutomataException&) {
+        threw = true;
+    }
+    test::check(threw, "RegexSet::Options::maxStates");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(17);
+    testAgainstSearchers(rng);
+    testStateLimit();
+    return test::finish("regex_set_test");
+}
@@ -0,0 +1,66 @@
+/**
+ * ShuffleDFA backends against CompiledDFA, on texts long enough to reach
+ * the vector kernels
+ */
+
+#include "automata/regex_parser.hpp"
+#include "automata/shuffle_dfa.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+using Backend = ShuffleDFA::Backend;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "GAATTC", "TATA[AT]A[AT]", "(AC)+G", "G(A|C)*T", "[AG]CC[ACGT]TGG", "A*", "(TAA|TAG|TGA)",
+};
+
+std::vector<size_t> referenceAccepting(const CompiledDFA& dfa, const std::string& text, bool backward) {
+    std::vector<size_t> positions;
+    CompiledDFA::Index state = dfa.getStartState();
+    const size_t n = text.size();
+    if (dfa.isAccepting(state)) positions.push_back(backward ? n : 0);
+    for (size_t i = 0; i < n && state != CompiledDFA::DEAD; ++i) {
+        state = dfa.next(state, static_cast<unsigned char>(text[backward ? n - 1 - i : i]));
+        if (dfa.isAccepting(state)) positions.push_back(backward ? n - 1 - i : i + 1);
+    }
+    return positions;
+}
+
+void testBackends(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        RegexParser parser;
+        CompiledDFA anchored = CompiledDFA::fromDFA(DFA::fromNFA(parser.parse(pattern)).minimize());
+        // Σ*L never dies, so the whole text goes through the kernels
+        for (const CompiledDFA& dfa : {anchored, anchored.unanchored()}) {
+            if (!ShuffleDFA::fits(dfa)) continue;
+            ShuffleDFA shuffle = ShuffleDFA::fromCompiled(dfa);
+            for (int it = 0; it < 60; ++it) {
+                std::string text = test::randomString(rng, rng() % (it % 4 ? 600 : 5000), "ACGTN", it % 5 ? 4 : 5);
+                for (Backend backend : {Backend::SCALAR, Backend::SSSE3, Backend::AVX2}) {
+                    shuffle.setBackend(backend);
+                    std::string what = pattern + " " + ShuffleDFA::backendName(shuffle.getBackend()) +
+                                       " length " + std::to_string(text.size());
+                    test::check(shuffle.accepts(text) == dfa.accepts(text), "accepts " + what);
+                    for (bool backward : {false, true}) {
+                        std::vector<size_t> positions;
+                        shuffle.findAccepting(text.data(), text.size(), backward, positions);
+                        test::check(positions == referenceAccepting(dfa, text, backward),
+                                    std::string("findAccepting ") + (backward ? "backward " : "") + what);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(17);
+    testBackends(rng);
+    return test::finish("shuffle_dfa_test");
+}
@@ -0,0 +1,75 @@
+/**
+ * StreamMatcher fed in random chunks against DFASearcher on the whole
+ * text, for every match kind
+ */
+
+#include "automata/dfa_search.hpp"
+#include "automata/regex_parser.hpp"
+#include "automata/stream_matcher.hpp"
+#include "test_support.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace automata;
+using Matches = std::vector<std::pair<size_t, size_t>>;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "", "GAATTC", "(TAA|TAG|TGA)", "A*", "AC*G", "(AC)+", "A|AC|ACGT", "G(A|C)*T", "C?", "A|A[ACGT]*G",
+    "(AA|A)*C?", "[ACGT]*T[ACGT]{2}", "A{2,4}C",
+};
+
+const MatchKind KINDS[] = {MatchKind::LEFTMOST_LONGEST, MatchKind::LEFTMOST_SHORTEST, MatchKind::ALL_OVERLAPPING};
+
+void testChunked(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        RegexParser parser;
+        DFA dfa = DFA::fromNFA(parser.parse(pattern)).minimize();
+        for (MatchKind kind : KINDS) {
+            DFASearcher searcher(dfa, kind);
+            Matches got;
+            StreamMatcher stream(dfa, kind, [&got](size_t start, size_t end) { got.emplace_back(start, end); });
+            for (int it = 0; it < 60; ++it) {
+                std::string text = test::randomString(rng, rng() % 400, "ACGT", it % 2 ? 4 : 2);
+                got.clear();
+                // Chunks down to single bytes, so matches straddle many boundaries
+                for (size_t i = 0; i < text.size();) {
+                    size_t chunk = std::min<size_t>(text.size() - i, rng() % (it % 3 == 0 ? 3 : 50));
+                    stream.feed(text.data() + i, chunk);
+                    i += chunk;
+                }
+                stream.finish();
+                if (kind == MatchKind::ALL_OVERLAPPING) std::sort(got.begin(), got.end());
+                test::check(got == searcher.findAll(text),
+                            pattern + " kind " + std::to_string(static_cast<int>(kind)) + " on " + text);
+            }
+        }
+    }
+}
+
+void testCarryLimit() {
+    // A match that never ends cannot be carried over forever
+    RegexParser parser;
+    StreamMatcher::Options options;
+    options.maxCarryBytes = 100;
+    StreamMatcher stream(DFA::fromNFA(parser.parse("A*C")).minimize(), MatchKind::LEFTMOST_LONGEST,
+                         [](size_t, size_t) {}, options);
+    bool threw = false;
+    try {
+        stream.feed(std::string(1000, 'A'));
+    } catch (const AutomataException&) {
+        threw = true;
+    }
+    test::check(threw, "StreamMatcher::Options::maxCarryBytes");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(20);
+    testChunked(rng);
+    testCarryLimit();
+    return test::finish("stream_matcher_test");
+}
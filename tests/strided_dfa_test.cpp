@@ -0,0 +1,111 @@
+/**
+ * StridedDFA against CompiledDFA for every stride, including texts with
+ * bytes outside the DNA alphabet, and DFASearcher on automata too large
+ * for ShuffleDFA
+ */
+
+#include "automata/dfa_search.hpp"
+#include "automata/regex_parser.hpp"
+#include "automata/strided_dfa.hpp"
+#include "test_support.hpp"
+
+#include <vector>
+
+using namespace automata;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "GAATTC", "(AC)+G", "G(A|C)*T", "A*", "[ACGT]{3}T[ACGT]{4}", "TATA[AT]A[AT][ACGT]{0,6}GG", "AC|ACGT|CGTA",
+};
+
+std::vector<size_t> referenceAccepting(const CompiledDFA& dfa, const std::string& text, bool backward) {
+    std::vector<size_t> positions;
+    CompiledDFA::Index state = dfa.getStartState();
+    const size_t n = text.size();
+    if (dfa.isAccepting(state)) positions.push_back(backward ? n : 0);
+    for (size_t i = 0; i < n && state != CompiledDFA::DEAD; ++i) {
+        state = dfa.next(state, static_cast<unsigned char>(text[backward ? n - 1 - i : i]));
+        if (dfa.isAccepting(state)) positions.push_back(backward ? n - 1 - i : i + 1);
+    }
+    return positions;
+}
+
+// Leftmost matches by restarting the anchored DFA at every position
+std::vector<std::pair<size_t, size_t>> restartSearch(const CompiledDFA& dfa, const std::string& text, MatchKind kind) {
+    std::vector<std::pair<size_t, size_t>> matches;
+    size_t pos = 0;
+    for (size_t start = 0; start <= text.size(); ++start) {
+        if (start < pos) continue;
+        std::vector<size_t> ends = referenceAccepting(dfa, text.substr(start), false);
+        if (ends.empty()) continue;
+        if (kind == MatchKind::ALL_OVERLAPPING) {
+            for (size_t end : ends) matches.emplace_back(start, start + end);
+            continue;
+        }
+        size_t end = start + (kind == MatchKind::LEFTMOST_LONGEST ? ends.back() : ends.front());
+        matches.emplace_back(start, end);
+        pos = end > start ? end : start + 1;
+    }
+    return matches;
+}
+
+void testStrides(std::mt19937& rng) {
+    for (const auto& pattern : PATTERNS) {
+        RegexParser parser;
+        CompiledDFA anchored = CompiledDFA::fromDFA(DFA::fromNFA(parser.parse(pattern)).minimize());
+        for (const CompiledDFA& dfa : {anchored, anchored.unanchored()}) {
+            for (unsigned stride : {1u, 2u, 4u}) {
+                StridedDFA strided = StridedDFA::fromCompiled(dfa, stride);
+                for (int it = 0; it < 60; ++it) {
+                    std::string text = test::randomString(rng, rng() % (it % 4 ? 100 : 3000), "ACGTNa", it % 3 ? 4 : 6);
+                    std::string what = pattern + " stride " + std::to_string(stride) + " on " + text.substr(0, 80);
+                    test::check(strided.run(dfa.getStartState(), text.data(), text.size()) ==
+                                    dfa.run(dfa.getStartState(), text.data(), text.size()),
+                                "run " + what);
+                    test::check(strided.accepts(text) == dfa.accepts(text), "accepts " + what);
+                    for (bool backward : {false, true}) {
+                        std::vector<size_t> positions;
+                        strided.findAccepting(text.data(), text.size(), backward, positions);
+                        test::check(positions == referenceAccepting(dfa, text, backward),
+                                    std::string("findAccepting ") + (backward ? "backward " : "") + what);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void testFits() {
+    RegexParser parser;
+    CompiledDFA dna = CompiledDFA::fromDFA(DFA::fromNFA(parser.parse("GAATTC")).minimize());
+    CompiledDFA other = CompiledDFA::fromDFA(DFA::fromNFA(parser.parse("GAN")).minimize());
+    test::check(StridedDFA::fits(dna, 4), "fits a DNA automaton");
+    test::check(!StridedDFA::fits(other, 4), "fits an automaton reading N");
+}
+
+void testSearcher(std::mt19937& rng) {
+    // More than 16 states in the full-text pass, so DFASearcher strides it
+    for (const char* pattern : {"[ACGT]{3}T[ACGT]{4}", "TATA[AT]A[AT][ACGT]{0,6}GG"}) {
+        RegexParser parser;
+        DFA dfa = DFA::fromNFA(parser.parse(pattern)).minimize();
+        for (MatchKind kind : {MatchKind::LEFTMOST_LONGEST, MatchKind::LEFTMOST_SHORTEST, MatchKind::ALL_OVERLAPPING}) {
+            DFASearcher searcher = DFASearcher::fromPattern(pattern, kind);
+            for (int it = 0; it < 40; ++it) {
+                std::string text = test::randomString(rng, rng() % 400, "ACGTN", it % 4 ? 4 : 5);
+                test::check(searcher.findAll(text) == restartSearch(*dfa.getCompiled(), text, kind),
+                            std::string("DFASearcher ") + pattern + " on " + text);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(7);
+    testStrides(rng);
+    testFits();
+    testSearcher(rng);
+    return test::finish("strided_dfa_test");
+}
@@ -0,0 +1,60 @@
+#ifndef TESTS_TEST_SUPPORT_HPP
+#define TESTS_TEST_SUPPORT_HPP
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+/**
+ * @brief Minimal helpers shared by the differential tests
+ *
+ * Each test is a plain executable registered with ctest: it runs its
+ * checks, prints the first few failures, and returns non-zero if any check
+ * failed.
+ */
+namespace test {
+
+inline int& failureCount() {
+    static int count = 0;
+    return count;
+}
+
+// Record a failed check; only the first ten are printed
+inline void check(bool ok, const std::string& what) {
+    if (ok) return;
+    if (++failureCount() <= 10) std::printf("FAIL %s\n", what.c_str());
+}
+
+// Process exit code for main()
+inline int finish(const char* name) {
+    if (failureCount()) {
+        std::printf("%s: %d failures\n", name, failureCount());
+        return 1;
+    }
+    std::printf("%s passed\n", name);
+    return 0;
+}
+
+// length letters drawn from the first `letters` bytes of alphabet
+inline std::string randomString(std::mt19937& rng, size_t length, const char* alphabet = "ACGT", size_t letters = 4) {
+    std::string s(length, alphabet[0]);
+    for (auto& c : s) c = alphabet[rng() % letters];
+    return s;
+}
+
+// Up to edits random substitutions, insertions and deletions of DNA bases
+inline std::string mutate(std::string s, int edits, std::mt19937& rng) {
+    for (int e = 0; e < edits; ++e) {
+        size_t pos = s.empty() ? 0 : rng() % (s.size() + 1);
+        switch (rng() % 3) {
+            case 0: if (pos < s.size()) s[pos] = "ACGT"[rng() % 4]; break;
+            case 1: s.insert(s.begin() + static_cast<std::ptrdiff_t>(pos), "ACGT"[rng() % 4]); break;
+            default: if (pos < s.size()) s.erase(pos, 1); break;
+        }
+    }
+    return s;
+}
+
+} // namespace test
+
+#endif // TESTS_TEST_SUPPORT_HPP